@@ -0,0 +1,110 @@
+// src/AdaptiveInterval.cpp
+#include "AdaptiveInterval.h"
+#include "Config.h"
+#include <Arduino.h>
+
+AdaptiveInterval::AdaptiveInterval() : _interval(UPDATE_INTERVAL) {}
+
+void AdaptiveInterval::update(centi_t room, bool roomValid, centi_t algae, bool algaeValid,
+                              unsigned long nowMs) {
+    uint16_t roomRate = track(_room, room, roomValid, nowMs);
+    uint16_t algaeRate = track(_algae, algae, algaeValid, nowMs);
+    _slewRate = max(roomRate, algaeRate);
+
+    if (!_enabled) {
+        return;
+    }
+    if (_slewRate >= ADAPT_FAST_SLEW) {
+        _steadyReadings = 0;
+        _interval = max(_interval / 2, _min);
+    } else if (_slewRate <= ADAPT_SLOW_SLEW) {
+        if (++_steadyReadings >= ADAPT_STEADY_READINGS) {
+            _steadyReadings = 0;
+            _interval = min(_interval * 2, MAX_UPDATE_INTERVAL);
+        }
+    } else {
+        _steadyReadings = 0;
+    }
+}
+
+uint16_t AdaptiveInterval::track(Track& t, centi_t value, bool valid, unsigned long nowMs) {
+    // The first good reading after a fault starts the role over instead of
+    // being compared with the faulted value
+    if (!valid) {
+        t.primed = false;
+        return 0;
+    }
+    if (!t.primed) {
+        t.primed = true;
+        t.level = (int32_t)value << 4;
+        t.baseline = value;
+        t.baselineMs = nowMs;
+        t.rate = 0;
+        return 0;
+    }
+
+    // EMA 1/4 on the reading keeps one noisy window from clearing the floor;
+    // it delays a ramp by a few readings but leaves its slope alone
+    t.level += (((int32_t)value << 4) - t.level) >> 2;
+    centi_t level = (t.level + 8) >> 4;
+    uint16_t change = abs((int32_t)level - t.baseline);
+    unsigned long elapsedMs = nowMs - t.baselineMs;
+    if (elapsedMs == 0) {
+        return t.rate;
+    }
+    if (change >= _noiseFloor) {
+        t.rate = ratePerMinute(change, elapsedMs);
+        t.baseline = level;
+        t.baselineMs = nowMs;
+    } else {
+        // Nothing resolved yet: the rate can be at most the floor over the
+        // time since the baseline, which falls as steady readings add up
+        uint16_t bound = ratePerMinute(_noiseFloor, elapsedMs);
+        t.rate = min(t.rate, bound);
+    }
+    return t.rate;
+}
+
+uint16_t AdaptiveInterval::ratePerMinute(uint16_t change, unsigned long elapsedMs) {
+    uint32_t rate = (uint32_t)change * 60000UL / elapsedMs;
+    return rate > 0xFFFF ? 0xFFFF : rate;
+}
+
+void AdaptiveInterval::setResolution(uint16_t stepCenti) {
+    _noiseFloor = ADAPT_NOISE_FLOOR + stepCenti;
+}
+
+void AdaptiveInterval::setEnabled(bool enabled) {
+    _enabled = enabled;
+    _steadyReadings = 0;
+    if (!enabled) {
+        _interval = max(_base, _min);
+    }
+}
+
+void AdaptiveInterval::setMinInterval(unsigned long ms) {
+    _min = constrain(ms, MIN_UPDATE_INTERVAL, MAX_UPDATE_INTERVAL);
+    _interval = max(_interval, _min);
+}
+
+void AdaptiveInterval::setBaseInterval(unsigned long ms) {
+    _base = constrain(ms, MIN_UPDATE_INTERVAL, MAX_UPDATE_INTERVAL);
+    _interval = max(_base, _min);
+    _steadyReadings = 0;
+}
+
+unsigned long AdaptiveInterval::baseInterval() const {
+    return _base;
+}
+
+bool AdaptiveInterval::enabled() const {
+    return _enabled;
+}
+
+unsigned long AdaptiveInterval::interval() const {
+    return _interval;
+}
+
+uint16_t AdaptiveInterval::slewRate() const {
+    return _slewRate;
+}
@@ -0,0 +1,60 @@
+// src/AdaptiveInterval.h
+#pragma once
+#include <stdint.h>
+#include "Config.h"
+#include "FixedPoint.h"
+
+// Picks the reading interval from how fast the room and algae temperatures
+// move. A fast slew halves the interval at once; only ADAPT_STEADY_READINGS
+// consecutive slow readings double it again, and rates between the two
+// thresholds leave it alone, so it does not hunt on noise.
+//
+// Each role keeps a baseline reading. The rate is the change since the
+// baseline over the time since it was taken, measured once that change
+// clears the noise floor, so a slow drift is resolved over as many readings
+// as it needs instead of vanishing into the floor on every short step.
+class AdaptiveInterval {
+public:
+    AdaptiveInterval();
+    // Size of one sensor code step, centi-degrees; a step this size plus
+    // ADAPT_NOISE_FLOOR counts as no change
+    void setResolution(uint16_t stepCenti);
+    // Feed each published reading; valid = false skips a faulted role
+    void update(centi_t room, bool roomValid, centi_t algae, bool algaeValid,
+                unsigned long nowMs);
+    void setEnabled(bool enabled);
+    bool enabled() const;
+    // Shortest interval a sampling window allows; the interval never goes
+    // below it or MIN_UPDATE_INTERVAL, whichever is longer
+    void setMinInterval(unsigned long ms);
+    // Starting interval, and the fixed one while adaptation is off;
+    // clamped to MIN/MAX_UPDATE_INTERVAL
+    void setBaseInterval(unsigned long ms);
+    unsigned long baseInterval() const;
+    unsigned long interval() const;
+    // |dT/dt| of the faster-moving role, centi-degrees per minute
+    uint16_t slewRate() const;
+private:
+    // Rate tracking for one role; a role's baseline only survives while the
+    // role stays valid
+    struct Track {
+        bool primed = false;
+        int32_t level = 0;  // Q4, lightly smoothed reading
+        centi_t baseline = 0;
+        unsigned long baselineMs = 0;
+        uint16_t rate = 0;
+    };
+
+    bool _enabled = ADAPTIVE_INTERVAL;
+    Track _room;
+    Track _algae;
+    unsigned long _base = UPDATE_INTERVAL;
+    unsigned long _min = MIN_UPDATE_INTERVAL;
+    unsigned long _interval;
+    uint16_t _slewRate = 0;
+    uint16_t _noiseFloor = ADAPT_NOISE_FLOOR;
+    uint8_t _steadyReadings = 0;
+
+    uint16_t track(Track& t, centi_t value, bool valid, unsigned long nowMs);
+    static uint16_t ratePerMinute(uint16_t change, unsigned long elapsedMs);
+};
@@ -0,0 +1,196 @@
+// src/AdcSampler.cpp
+#include "AdcSampler.h"
+#include "Config.h"
+#include <Arduino.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+static uint32_t quietCount = 0;
+
+// Arduino core (wiring.c) Timer0 bookkeeping behind millis() and micros()
+extern volatile unsigned long timer0_overflow_count;
+extern volatile unsigned long timer0_millis;
+static uint8_t creditedFract = 0;
+
+// Timer0 is stopped while the CPU sleeps in ADC noise-reduction mode; put
+// the ~104 us conversion (26 ticks of 4 us) back so millis() and micros()
+// keep wall time. A wrap is accounted the way TIMER0_OVF_vect would.
+static void creditTimer0(uint8_t ticks) {
+    uint16_t count = TCNT0 + ticks;
+    if (count > 0xFF) {
+        count -= 0x100;
+        timer0_overflow_count++;
+        timer0_millis += 1;  // 1024 us: 1 ms plus 3/125 ms, as in wiring.c
+        creditedFract += 3;
+        if (creditedFract >= 125) {
+            creditedFract -= 125;
+            timer0_millis += 1;
+        }
+    }
+    TCNT0 = count;
+}
+
+uint8_t AdcSampler::muxFor(uint8_t pin, uint8_t reference) {
+    uint8_t channel = pin >= A0 ? pin - A0 : pin;
+    return reference | (channel & 0x07);
+}
+
+void AdcSampler::select(uint8_t mux) {
+    ADMUX = mux;
+}
+
+uint16_t AdcSampler::convert() {
+    ADCSRA |= _BV(ADSC);
+    while (ADCSRA & _BV(ADSC)) {
+        // ~104 us at the 125 kHz ADC clock
+    }
+    return ADC;
+}
+
+uint16_t AdcSampler::convertQuiet() {
+#if ADC_ISR_MODE
+    return convert();  // Free-running mode owns ADC_vect and needs Timer1
+#else
+    ADCSRA |= _BV(ADIE);
+    set_sleep_mode(SLEEP_MODE_ADC);
+    sleep_enable();
+    // Start explicitly so an already-pending wakeup can't skip the
+    // conversion; sample-and-hold happens after sleep is entered (1.5 ADC
+    // clocks), and any other wakeup just goes back to sleep. ADSC is tested
+    // with interrupts off: the instruction after sei() always runs first, so
+    // a completion between the test and the sleep still wakes the CPU
+    // instead of leaving it asleep with Timer0 stopped.
+    ADCSRA |= _BV(ADSC);
+    cli();
+    while (ADCSRA & _BV(ADSC)) {
+        sei();
+        sleep_cpu();
+        cli();
+    }
+    creditTimer0(QUIET_CONVERSION_US / 4);
+    sei();
+    sleep_disable();
+    ADCSRA &= ~_BV(ADIE);
+    quietCount++;
+    return ADC;
+#endif
+}
+
+uint32_t AdcSampler::quietConversions() {
+    return quietCount;
+}
+
+#if !ADC_ISR_MODE
+EMPTY_INTERRUPT(ADC_vect);  // Only wakes the CPU from convertQuiet()
+#endif
+
+#if ADC_ISR_MODE
+#include "RingBuffer.h"
+#include <avr/interrupt.h>
+
+// Samples are packed as channel index (top 4 bits) + 10-bit result
+static RingBuffer<uint16_t, 32> samples;
+static uint8_t muxTable[AdcSampler::MAX_CHANNELS + 1];
+static volatile uint8_t channelCount = 0;
+static volatile uint8_t currentChannel = 0;
+static volatile uint8_t bandgapInterval = 0;
+static volatile uint8_t rotations = 0;
+static volatile uint16_t droppedSamples = 0;
+
+static const uint32_t TIMER1_TICK_HZ = F_CPU / 64;
+
+void AdcSampler::begin(const uint8_t* pins, uint8_t count, uint16_t sampleRateHz,
+                       uint8_t reference, uint8_t bandgapEvery) {
+    stop();
+    if (count > MAX_CHANNELS) {
+        count = MAX_CHANNELS;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        muxTable[i] = muxFor(pins[i], reference);
+        DIDR0 |= _BV(muxTable[i] & 0x07);  // Digital input buffer off
+    }
+    muxTable[count] = reference | MUX_BANDGAP;
+    channelCount = count;
+    currentChannel = 0;
+    bandgapInterval = bandgapEvery;
+    rotations = 0;
+    droppedSamples = 0;
+    samples.clear();
+
+    ADMUX = muxTable[0];
+    ADCSRB = _BV(ADTS2) | _BV(ADTS0);  // Trigger source: Timer1 compare match B
+    ADCSRA = _BV(ADEN) | _BV(ADATE) | _BV(ADIE) | _BV(ADIF)
+           | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);  // 125 kHz ADC clock
+
+    // Timer1 in CTC mode, /64 prescaler: one trigger per period
+    uint32_t top = TIMER1_TICK_HZ / (sampleRateHz ? sampleRateHz : 1) - 1;
+    if (top > 0xFFFF) {
+        top = 0xFFFF;
+    }
+    TCCR1A = 0;
+    TCCR1B = 0;
+    TCNT1 = 0;
+    OCR1A = top;
+    OCR1B = top;
+    TIFR1 = _BV(OCF1B);
+    TCCR1B = _BV(WGM12) | _BV(CS11) | _BV(CS10);
+}
+
+void AdcSampler::stop() {
+    TCCR1B = 0;
+    ADCSRA = _BV(ADEN) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);  // Back to analogRead() setup
+    ADCSRB = 0;
+    channelCount = 0;
+}
+
+bool AdcSampler::read(uint8_t& channel, uint16_t& value) {
+    uint16_t packed;
+    if (!samples.pop(packed)) {
+        return false;
+    }
+    channel = packed >> 12;
+    value = packed & 0x03FF;
+    return true;
+}
+
+void AdcSampler::clear() {
+    samples.clear();
+    noInterrupts();
+    droppedSamples = 0;
+    interrupts();
+}
+
+uint16_t AdcSampler::dropped() {
+    uint16_t count;
+    noInterrupts();
+    count = droppedSamples;
+    interrupts();
+    return count;
+}
+
+ISR(ADC_vect) {
+    uint16_t value = ADC;
+    uint8_t channel = currentChannel;
+
+    // The next conversion waits for the timer, so the mux can change now and
+    // has a full sample period to settle (the bandgap needs ~70 us)
+    uint8_t next = channel + 1;
+    if (channel >= channelCount) {
+        next = 0;  // Just measured the bandgap
+    } else if (next >= channelCount) {
+        next = 0;
+        if (bandgapInterval && ++rotations >= bandgapInterval) {
+            rotations = 0;
+            next = channelCount;
+        }
+    }
+    ADMUX = muxTable[next];
+    currentChannel = next;
+    TIFR1 = _BV(OCF1B);  // Re-arm the auto-trigger edge
+
+    if (!samples.push(((uint16_t)channel << 12) | value)) {
+        droppedSamples++;
+    }
+}
+
+#endif  // ADC_ISR_MODE
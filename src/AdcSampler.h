@@ -0,0 +1,40 @@
+// src/AdcSampler.h
+#pragma once
+#include <stdint.h>
+
+// Register-level ADC access. Polled mode converts one preselected input at a
+// time; with ADC_ISR_MODE, Timer1 compare match B auto-triggers conversions
+// and ADC_vect rotates the mux through the configured pins, queueing samples
+// for SensorManager to drain from loop(). Owns Timer1 and the ADC while running.
+class AdcSampler {
+public:
+    // ADMUX reference selection bits
+    static const uint8_t REF_AVCC = 0x40;
+    static const uint8_t REF_INTERNAL_1V1 = 0xC0;
+    static const uint8_t MUX_BANDGAP = 0x0E;
+    static const uint8_t MAX_CHANNELS = 8;
+    static const uint8_t QUIET_CONVERSION_US = 104;  // 13 ADC clocks at 125 kHz
+
+    static uint8_t muxFor(uint8_t pin, uint8_t reference);
+
+    // Polled: select() the next input early so it settles before convert()
+    static void select(uint8_t mux);
+    static uint16_t convert();
+    // As convert(), but sleeps in ADC noise-reduction mode for a cleaner
+    // result. clkIO stops for the ~104 us conversion: the USART and TWI
+    // freeze mid-byte, so only call it with both idle (see SensorManager).
+    // Timer0 stops too; the lost ticks are credited back to millis()/micros().
+    static uint16_t convertQuiet();
+    static uint32_t quietConversions();
+
+    // Free-running: pins are rotated in order; if bandgapEvery is non-zero the
+    // internal bandgap is inserted after that many rotations and reported as
+    // channel == count.
+    static void begin(const uint8_t* pins, uint8_t count, uint16_t sampleRateHz,
+                      uint8_t reference, uint8_t bandgapEvery);
+    static void stop();
+    // Pops the oldest sample; channel is the index into the pin list
+    static bool read(uint8_t& channel, uint16_t& value);
+    static void clear();
+    static uint16_t dropped();
+};
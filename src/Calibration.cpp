@@ -0,0 +1,135 @@
+// src/Calibration.cpp
+#include "Calibration.h"
+#include "Config.h"
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <stddef.h>
+#include "Crc16.h"
+
+bool Calibration::load() {
+    EEPROM.get(CAL_EEPROM_ADDRESS, _record);
+    if (_record.version != VERSION || _record.crc != checksum()) {
+        reset();
+        return false;
+    }
+    for (uint8_t slot = 0; slot < SLOTS; slot++) {
+        if (_record.count[slot] > MAX_POINTS) {
+            _record.count[slot] = 0;
+        }
+        rebuild(slot);
+    }
+    return true;
+}
+
+void Calibration::save() {
+    _record.version = VERSION;
+    _record.crc = checksum();
+    EEPROM.put(CAL_EEPROM_ADDRESS, _record);  // Only rewrites bytes that changed
+}
+
+void Calibration::reset() {
+    _record.version = VERSION;
+    for (uint8_t slot = 0; slot < SLOTS; slot++) {
+        _record.count[slot] = 0;
+    }
+}
+
+uint16_t Calibration::checksum() const {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&_record);
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < offsetof(Record, crc); i++) {
+        crc = crc16Update(crc, bytes[i]);
+    }
+    return crc;
+}
+
+// Corrected values are worked out in 32 bits and clamped, so a reading
+// toCentiDegrees() saturated at 32767 stays saturated instead of wrapping
+// to a large negative temperature
+centi_t Calibration::apply(uint8_t slot, centi_t value) const {
+    if (slot >= SLOTS) {
+        return value;
+    }
+    uint8_t count = _record.count[slot];
+    const Point* points = _record.points[slot];
+    if (count == 0) {
+        return value;
+    }
+    if (count == 1) {
+        return clampCenti((int32_t)value + points[0].reference - points[0].measured);
+    }
+
+    // Segment whose upper breakpoint is above value (or the last one)
+    uint8_t seg = 0;
+    while (seg < count - 2 && value >= points[seg + 1].measured) {
+        seg++;
+    }
+    int32_t delta = ((int32_t)value - points[seg].measured) * _gainQ12[slot][seg];
+    return clampCenti(points[seg].reference + (delta >> 12));
+}
+
+centi_t Calibration::clampCenti(int32_t value) {
+    return constrain(value, -32767L, 32767L);
+}
+
+bool Calibration::addPoint(uint8_t slot, centi_t measured, centi_t reference) {
+    if (slot >= SLOTS) {
+        return false;
+    }
+    uint8_t& count = _record.count[slot];
+    Point* points = _record.points[slot];
+
+    // Drop a point at the same or nearest measured value to make room
+    uint8_t replace = count;
+    int16_t nearest = 0x7FFF;
+    for (uint8_t i = 0; i < count; i++) {
+        int16_t distance = abs(points[i].measured - measured);
+        if (distance < nearest) {
+            nearest = distance;
+            replace = i;
+        }
+    }
+    if (nearest > 0 && count < MAX_POINTS) {
+        replace = count++;
+    }
+    points[replace].measured = measured;
+    points[replace].reference = reference;
+
+    // Insertion sort by measured value
+    for (uint8_t i = 1; i < count; i++) {
+        Point p = points[i];
+        uint8_t j = i;
+        while (j > 0 && points[j - 1].measured > p.measured) {
+            points[j] = points[j - 1];
+            j--;
+        }
+        points[j] = p;
+    }
+    rebuild(slot);
+    return true;
+}
+
+void Calibration::clear(uint8_t slot) {
+    if (slot < SLOTS) {
+        _record.count[slot] = 0;
+    }
+}
+
+uint8_t Calibration::pointCount(uint8_t slot) const {
+    return slot < SLOTS ? _record.count[slot] : 0;
+}
+
+Calibration::Point Calibration::point(uint8_t slot, uint8_t index) const {
+    return _record.points[slot][index];
+}
+
+void Calibration::rebuild(uint8_t slot) {
+    const Point* points = _record.points[slot];
+    for (uint8_t seg = 0; seg + 1 < _record.count[slot]; seg++) {
+        int32_t dx = points[seg + 1].measured - points[seg].measured;
+        int32_t dy = points[seg + 1].reference - points[seg].reference;
+        int32_t gain = dx != 0 ? (dy << 12) / dx : 4096;
+        // Clamp to a sane range (0.25x-4x); a wild gain means a bad point
+        _gainQ12[slot][seg] = constrain(gain, 1024, 16384);
+    }
+}
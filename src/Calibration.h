@@ -0,0 +1,48 @@
+// src/Calibration.h
+#pragma once
+#include <stdint.h>
+#include "FixedPoint.h"
+
+// Per-slot reference points mapping measured to true temperature. One point
+// is a pure offset; two or more form a piecewise-linear curve, extrapolated
+// from the end segments. Segment gains are precomputed (Q12) whenever points
+// change, so apply() is a multiply and shift with no division.
+class Calibration {
+public:
+    static const uint8_t SLOTS = 6;
+    static const uint8_t MAX_POINTS = 3;
+
+    struct Point {
+        centi_t measured;
+        centi_t reference;
+    };
+
+    // Returns false (and starts uncalibrated) if EEPROM is blank or corrupt
+    bool load();
+    void save();
+
+    centi_t apply(uint8_t slot, centi_t value) const;
+    // Replaces the nearest existing point if the slot is full
+    bool addPoint(uint8_t slot, centi_t measured, centi_t reference);
+    void clear(uint8_t slot);
+    uint8_t pointCount(uint8_t slot) const;
+    Point point(uint8_t slot, uint8_t index) const;
+
+private:
+    static const uint8_t VERSION = 1;
+
+    struct Record {
+        uint8_t version;
+        uint8_t count[SLOTS];
+        Point points[SLOTS][MAX_POINTS];  // Sorted by measured
+        uint16_t crc;
+    };
+
+    Record _record;
+    int16_t _gainQ12[SLOTS][MAX_POINTS - 1];
+
+    void reset();
+    void rebuild(uint8_t slot);
+    static centi_t clampCenti(int32_t value);
+    uint16_t checksum() const;
+};
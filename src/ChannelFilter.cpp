@@ -0,0 +1,113 @@
+// src/ChannelFilter.cpp
+#include "ChannelFilter.h"
+#include "Config.h"
+#include <Arduino.h>
+
+void ChannelFilter::configure(FilterKind kind, uint8_t param) {
+    _kind = kind;
+    switch (kind) {
+        case FILTER_EMA:
+            _param = param ? constrain(param, 1, 6) : FILTER_EMA_SHIFT;
+            break;
+        case FILTER_KALMAN:
+            _param = param ? constrain(param, 1, 200) : FILTER_KALMAN_NOISE;
+            break;
+        default:
+            _param = 0;
+            break;
+    }
+    reset();
+}
+
+void ChannelFilter::reset() {
+    _count = 0;
+    _s.median.head = 0;
+}
+
+FilterKind ChannelFilter::kind() const {
+    return _kind;
+}
+
+uint8_t ChannelFilter::param() const {
+    return _param;
+}
+
+centi_t ChannelFilter::update(centi_t sample) {
+    switch (_kind) {
+        case FILTER_EMA:
+            if (_count == 0) {
+                _count = 1;
+                _s.ema.value = (int32_t)sample << 8;
+            } else {
+                // y += (x - y) / 2^n. With 8 fractional bits the increment
+                // only rounds to zero within 1/4 centi of x at n = 6; with
+                // 4 the output stalled up to 2^(n-4) centi short of a step.
+                _s.ema.value += (((int32_t)sample << 8) - _s.ema.value) >> _param;
+            }
+            return (_s.ema.value + 128) >> 8;
+        case FILTER_MEDIAN:
+            return updateMedian(sample);
+        case FILTER_KALMAN:
+            return updateKalman(sample);
+        default:
+            return sample;
+    }
+}
+
+// Evicts the oldest sample from the sorted window and inserts the new one in
+// place, so each update is at most MEDIAN_WINDOW moves with no full sort.
+centi_t ChannelFilter::updateMedian(centi_t sample) {
+    centi_t* sorted = _s.median.sorted;
+    uint8_t n = _count;
+
+    if (n == MEDIAN_WINDOW) {
+        centi_t oldest = _s.median.history[_s.median.head];
+        uint8_t i = 0;
+        while (sorted[i] != oldest) {
+            i++;
+        }
+        for (; i + 1 < n; i++) {
+            sorted[i] = sorted[i + 1];
+        }
+        n--;
+    } else {
+        _count++;
+    }
+
+    uint8_t i = n;
+    while (i > 0 && sorted[i - 1] > sample) {
+        sorted[i] = sorted[i - 1];
+        i--;
+    }
+    sorted[i] = sample;
+
+    _s.median.history[_s.median.head] = sample;
+    _s.median.head = (_s.median.head + 1) % MEDIAN_WINDOW;
+    return sorted[_count / 2];
+}
+
+// Scalar Kalman filter on a random-walk model: predict adds process noise Q,
+// then the gain K = P / (P + R) (Q8) blends in the measurement.
+centi_t ChannelFilter::updateKalman(centi_t sample) {
+    if (_count == 0) {
+        _count = 1;
+        _s.kalman.estimate = (int32_t)sample << 4;
+        _s.kalman.variance = (uint32_t)_param * _param;
+        return sample;
+    }
+    uint32_t r = (uint32_t)_param * _param;
+    uint32_t p = _s.kalman.variance + FILTER_KALMAN_Q;
+    uint16_t gain = (p << 8) / (p + r);
+    _s.kalman.estimate += ((((int32_t)sample << 4) - _s.kalman.estimate) * gain) >> 8;
+    _s.kalman.variance = (p * (256 - gain)) >> 8;
+    return (_s.kalman.estimate + 8) >> 4;
+}
+
+void printFilterName(Print& out, FilterKind kind) {
+    switch (kind) {
+        case FILTER_EMA:    out.print(F("ema")); break;
+        case FILTER_MEDIAN: out.print(F("median")); break;
+        case FILTER_KALMAN: out.print(F("kalman")); break;
+        default:            out.print(F("none")); break;
+    }
+}
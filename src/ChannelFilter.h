@@ -0,0 +1,48 @@
+// src/ChannelFilter.h
+#pragma once
+#include <stdint.h>
+#include "FixedPoint.h"
+
+enum FilterKind : uint8_t { FILTER_NONE, FILTER_EMA, FILTER_MEDIAN, FILTER_KALMAN };
+
+// Per-channel smoothing applied to each published reading. Every kind is
+// integer-only and does constant work per sample (the median keeps a tiny
+// sorted window). State for the active kind shares one union.
+class ChannelFilter {
+public:
+    static const uint8_t MEDIAN_WINDOW = 5;
+
+    // param: EMA shift (1-6, weight 1/2^n), Kalman measurement noise in
+    // centi-degrees (1-200); ignored by the median. 0 picks the default.
+    void configure(FilterKind kind, uint8_t param = 0);
+    void reset();
+    centi_t update(centi_t sample);
+
+    FilterKind kind() const;
+    uint8_t param() const;
+
+private:
+    FilterKind _kind = FILTER_NONE;
+    uint8_t _param = 0;
+    uint8_t _count = 0;
+
+    union {
+        struct {
+            int32_t value;  // Q8
+        } ema;
+        struct {
+            centi_t history[MEDIAN_WINDOW];  // Arrival order, circular
+            centi_t sorted[MEDIAN_WINDOW];
+            uint8_t head;
+        } median;
+        struct {
+            int32_t estimate;  // Q4 centi-degrees
+            uint32_t variance; // centi-degrees^2
+        } kalman;
+    } _s;
+
+    centi_t updateMedian(centi_t sample);
+    centi_t updateKalman(centi_t sample);
+};
+
+void printFilterName(Print& out, FilterKind kind);
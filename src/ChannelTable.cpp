@@ -0,0 +1,13 @@
+// src/ChannelTable.cpp
+#include "ChannelTable.h"
+
+void printChannelName(Print& out, ChannelRole role, uint8_t pin) {
+    switch (role) {
+        case ROLE_ROOM:  out.print(F("Room")); break;
+        case ROLE_ALGAE: out.print(F("Algae")); break;
+        default:         out.print(F("Aux")); break;
+    }
+    out.print(F(" (A"));
+    out.print(pin - A0);
+    out.print(')');
+}
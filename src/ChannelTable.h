@@ -0,0 +1,86 @@
+// src/ChannelTable.h
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+#include "ChannelFilter.h"
+
+enum ChannelRole : uint8_t { ROLE_ROOM, ROLE_ALGAE, ROLE_AUX };
+
+struct ChannelDesc {
+    uint8_t pin;
+    ChannelRole role;
+    FilterKind filter;
+    uint8_t calSlot;
+};
+
+constexpr ChannelDesc SENSOR_CHANNELS[] = { SENSOR_CHANNEL_TABLE };
+constexpr uint8_t SENSOR_CHANNEL_COUNT = sizeof(SENSOR_CHANNELS) / sizeof(SENSOR_CHANNELS[0]);
+
+constexpr int8_t channelForRole(ChannelRole role, uint8_t i = 0) {
+    return i >= SENSOR_CHANNEL_COUNT ? -1
+         : SENSOR_CHANNELS[i].role == role ? i
+         : channelForRole(role, i + 1);
+}
+
+constexpr uint8_t ROOM_CHANNEL = channelForRole(ROLE_ROOM);
+constexpr uint8_t ALGAE_CHANNEL = channelForRole(ROLE_ALGAE);
+
+static_assert(SENSOR_CHANNEL_COUNT >= 1 && SENSOR_CHANNEL_COUNT <= 6, "1-6 analog channels supported");
+static_assert(channelForRole(ROLE_ROOM) >= 0 && channelForRole(ROLE_ALGAE) >= 0,
+              "SENSOR_CHANNEL_TABLE needs a room and an algae channel");
+
+// Compile-time view of one table entry. Every field is a constant, so code
+// generated per channel carries no table lookups at runtime.
+template <uint8_t I>
+struct Channel {
+    static_assert(I < SENSOR_CHANNEL_COUNT, "channel index out of range");
+    static constexpr uint8_t pin = SENSOR_CHANNELS[I].pin;
+    static constexpr ChannelRole role = SENSOR_CHANNELS[I].role;
+    static constexpr FilterKind filter = SENSOR_CHANNELS[I].filter;
+    static constexpr uint8_t calSlot = SENSOR_CHANNELS[I].calSlot;
+    static_assert(pin >= A0 && pin <= A5, "sensor channels must be analog inputs A0-A5");
+};
+
+template <uint8_t I> constexpr uint8_t Channel<I>::pin;
+template <uint8_t I> constexpr ChannelRole Channel<I>::role;
+template <uint8_t I> constexpr FilterKind Channel<I>::filter;
+template <uint8_t I> constexpr uint8_t Channel<I>::calSlot;
+
+// Calls f.visit<I>() for every channel, unrolled at compile time
+template <uint8_t I, uint8_t N = SENSOR_CHANNEL_COUNT>
+struct ChannelLoop {
+    template <class F> static void run(F f) {
+        f.template visit<I>();
+        ChannelLoop<I + 1, N>::run(f);
+    }
+};
+
+template <uint8_t N>
+struct ChannelLoop<N, N> {
+    template <class F> static void run(F) {}
+};
+
+template <class F>
+inline void forEachChannel(F f) {
+    ChannelLoop<0>::run(f);
+}
+
+template <class F>
+struct ChannelSelect {
+    uint8_t index;
+    F f;
+    template <uint8_t I> void visit() {
+        if (I == index) {
+            f.template visit<I>();
+        }
+    }
+};
+
+// Calls f.visit<I>() only for the channel whose index matches at runtime
+template <class F>
+inline void visitChannel(uint8_t index, F f) {
+    forEachChannel(ChannelSelect<F>{index, f});
+}
+
+// Prints e.g. "Room (A0)"
+void printChannelName(Print& out, ChannelRole role, uint8_t pin);
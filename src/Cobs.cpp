@@ -0,0 +1,26 @@
+// src/Cobs.cpp
+#include "Cobs.h"
+
+// Each zero is replaced by the distance to the next one; a code byte of
+// 0xFF marks a 254-byte run with no zero. Packets here are far shorter.
+uint8_t Cobs::encode(const uint8_t* in, uint8_t length, uint8_t* out) {
+    uint8_t codeIndex = 0;
+    uint8_t outIndex = 1;
+    uint8_t code = 1;
+    for (uint8_t i = 0; i < length; i++) {
+        if (in[i] == 0) {
+            out[codeIndex] = code;
+            codeIndex = outIndex++;
+            code = 1;
+            continue;
+        }
+        out[outIndex++] = in[i];
+        if (++code == 0xFF) {
+            out[codeIndex] = code;
+            codeIndex = outIndex++;
+            code = 1;
+        }
+    }
+    out[codeIndex] = code;
+    return outIndex;
+}
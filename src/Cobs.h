@@ -0,0 +1,13 @@
+// src/Cobs.h
+#pragma once
+#include <stdint.h>
+
+// Consistent Overhead Byte Stuffing: removes every 0x00 from a packet so a
+// 0x00 can delimit frames on the wire. No Arduino dependency, so the
+// native tests build it as is.
+class Cobs {
+public:
+    // Encodes length (< 254) bytes; out needs length + 1. Returns the
+    // encoded length, without the 0x00 delimiter.
+    static uint8_t encode(const uint8_t* in, uint8_t length, uint8_t* out);
+};
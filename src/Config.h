@@ -7,17 +7,129 @@
 #define ROOM_TEMP_PIN A0
 #define ALGAE_TEMP_PIN A1
 
-// LCD Configuration
+// Analog sensor channels: { pin, role, filter, calibration slot }. Needs one
+// ROLE_ROOM and one ROLE_ALGAE entry; add ROLE_AUX rows for up to A0-A5.
+// Filters: FILTER_NONE, FILTER_EMA, FILTER_MEDIAN, FILTER_KALMAN
+#define SENSOR_CHANNEL_TABLE \
+    { ROOM_TEMP_PIN,  ROLE_ROOM,  FILTER_NONE, 0 }, \
+    { ALGAE_TEMP_PIN, ROLE_ALGAE, FILTER_NONE, 1 }
+
+// DS18B20 probes on a OneWire bus (4.7k pull-up to 5V). Probes found at
+// boot take the roles below in ROM order and replace the LM35 for that role;
+// reassign at runtime with "onewire assign".
+#define ENABLE_DS18B20 0
+#define ONEWIRE_PIN 2
+#define DS18B20_CONVERSION_MS 750  // 12-bit conversion time
+#define DS18B20_DEFAULT_ROLES ROLE_ROOM, ROLE_ALGAE
+
+// SHT3x humidity sensor on the LCD's I2C bus (SDA A4, SCL A5). Detected at
+// boot; without one humidity is simply not reported.
+#define ENABLE_HUMIDITY 1
+#define HUMIDITY_ADDRESS 0x44   // 0x45 with ADDR pulled high
+#define HUMIDITY_MEASURE_MS 16  // High-repeatability single shot
+
+// I2C bus (TwiMaster)
+#define I2C_CLOCK_HZ 100000   // PCF8574 LCD backpack's rated limit
+#define TWI_STREAM_SIZE 128   // Display byte queue; 4 bytes per LCD character
+#define TWI_PACKET_SLOTS 16   // Queued SSD1306 transactions
+#define TWI_TIMEOUT_MS 25     // Transaction time before the bus is reset
+
+// Display Configuration
+#define DISPLAY_HD44780 0     // Character LCD on a PCF8574 backpack
+#define DISPLAY_SSD1306 1     // 128x64 OLED as 16x8 text
+#define DISPLAY_BACKEND DISPLAY_HD44780
 #define LCD_ADDRESS 0x27
-#define LCD_COLS 16
+#define LCD_COLS 16           // 16x2 or 20x4 modules
 #define LCD_ROWS 2
+#define OLED_ADDRESS 0x3C     // 0x3D with SA0 high
+#define LCD_BYTES_PER_POLL 2  // Characters/commands queued per loop() pass
+#define PAGE_ROTATE_MS 4000   // Auto-rotation period between display pages
+#define PAGE_BUTTON_PIN 3     // Push button to GND steps pages; -1 for none
+
+// Serial console (SerialCommander). Rates exact at 16 MHz: 250000, 500000,
+// 1000000; 115200 is 2.1% off but what most terminals default to. The TX
+// ring size is a core setting: see build_flags in platformio.ini.
+#define SERIAL_BAUD 115200
+#define SERIAL_LINE_SIZE 40       // Longest command line; longer ones are rejected
+#define SERIAL_BYTES_PER_POLL 16  // Received bytes consumed per loop() pass
+#define TELEMETRY_NODE_ID 1       // Sent in every binary telemetry packet
+#define TRACE_LINE_SIZE 110       // TX room held per debug line; longer lines are cut
+#define TRACE_BYTES_PER_SEC 2000  // Debug trace budget, ~17% of 115200 baud
+#define TRACE_BURST_BYTES 400
+
+// Modbus RTU slave (see ModbusSlave.h). "modbus on" hands the serial port to
+// it; a master writes holding register 5 = 0 to give it back.
+#define ENABLE_MODBUS 1
+#define MODBUS_AT_BOOT 0      // 1: start in Modbus mode (unattended RS-485 nodes)
+#define MODBUS_ADDRESS 1      // Slave address, 1-247
+#define MODBUS_BAUD 19200     // 8E1
+#define MODBUS_DE_PIN 4       // RS-485 driver enable (DE and /RE tied); -1 for none
 
 // LM35 Configuration
-#define SAMPLES_PER_READ 10
+#define SAMPLES_PER_READ 10   // Boxcar length when oversampling is off
+#define OVERSAMPLE_BITS 2     // Extra bits by 4^n oversample + decimate (0-3)
+#define SAMPLE_SPACING_MS 10  // Gap between polled conversions within a window
+
+// Interrupt-driven sampling: Timer1 triggers the ADC at a fixed rate and
+// ADC_vect round-robins the channels (takes over Timer1, i.e. PWM on D9/D10)
+#define ADC_ISR_MODE 0
+#define ADC_SAMPLE_RATE_HZ 200  // Conversions per second across all channels
 #define ADC_RESOLUTION 1024.0
 #define REFERENCE_VOLTAGE 5.0
 #define MV_PER_DEGREE 10.0
 
+// Reading filters (defaults when no parameter is given)
+#define FILTER_EMA_SHIFT 2       // EMA weight 1/2^n per reading
+#define FILTER_KALMAN_NOISE 20   // Measurement noise, centi-degrees (R = n^2)
+#define FILTER_KALMAN_Q 25       // Process noise per reading, centi-degrees^2
+
+// Sensor fault thresholds (see README troubleshooting)
+#define FAULT_OPEN_MV 2            // Whole window at or below this: output open
+#define FAULT_MAX_TEMP 12500       // Centi-degrees; above this: wiring fault
+#define FAULT_MAX_SPREAD_MV 40     // Max-min within one window
+#define FAULT_MAX_SLEW 100         // Centi-degrees per second between windows
+#define FAULT_SLEW_CODES 2         // ADC codes of change always allowed between windows
+#define FAULT_STUCK_MINUTES 180    // Identical noise-free windows this long: STUCK
+
+// ADC reference: 0 = AVcc taken as REFERENCE_VOLTAGE, 1 = AVcc measured
+// against the internal bandgap, 2 = internal 1.1 V reference (0-110 C)
+#define DEFAULT_VREF_MODE 1
+#define BANDGAP_MV 1100       // Nominal; trim per chip (1.0-1.2 V) from AREF
+#define REF_SETTLE_MS 10      // Discard conversions after a reference switch
+#define BANDGAP_ROTATIONS 16  // ISR mode: bandgap sampled every N channel rotations
+
+// EEPROM layout
+#define CAL_EEPROM_ADDRESS 0  // Calibration record (version + CRC16)
+
+// Power estimates for the `power` report (ATmega328P at 16 MHz; board
+// regulators, USB bridge and LEDs are not included)
+#define POWER_SUPPLY_MV 5000
+#define POWER_ACTIVE_UA 9500
+#define POWER_IDLE_UA 3500
+#define POWER_ADC_SLEEP_UA 1100
+
+// Adaptive reading interval (see AdaptiveInterval.h). Slew rates are in
+// centi-degrees per minute; UPDATE_INTERVAL is the starting interval and the
+// fixed one when adaptation is off.
+#define ADAPTIVE_INTERVAL 1
+#define ADAPT_FAST_SLEW 60        // 0.6 C/min or faster: halve the interval
+#define ADAPT_SLOW_SLEW 15        // 0.15 C/min or slower: may double it
+#define ADAPT_STEADY_READINGS 5   // Slow readings in a row before doubling
+#define ADAPT_NOISE_FLOOR 10      // Changes within one ADC code plus this are unresolved
+
+// Cooperative scheduler (see Scheduler.h and main.cpp); 30 bytes of RAM per
+// slot, sized to the tasks setup() registers
+#define SCHEDULER_MAX_TASKS 6
+
+// Latency histograms for the `perf` command (see Perf.h). Off by default:
+// they take ~200 bytes of RAM the stack needs on a 2 KB Uno
+#define ENABLE_PERF 0
+
 // Timing
 const unsigned long UPDATE_INTERVAL = 2000;
+// A sampling window takes 4^OVERSAMPLE_BITS conversions per channel
+// SAMPLE_SPACING_MS apart (~1.3 s for two channels at 3 bits), so the
+// adaptive interval is also held at or above the current window length
+const unsigned long MIN_UPDATE_INTERVAL = 500;
+const unsigned long MAX_UPDATE_INTERVAL = 16000;
 const unsigned long FLUCTUATION_INTERVAL = 1000;
@@ -0,0 +1,29 @@
+// src/Crc16.h
+#pragma once
+#include <stdint.h>
+#ifdef __AVR__
+#include <util/crc16.h>
+#endif
+
+// CRC-16/MODBUS (reflected polynomial 0xA001, initial 0xFFFF), as used by
+// binary telemetry and Modbus RTU; sent low byte first. On AVR this is
+// avr-libc's _crc16_update, elsewhere (native tests) the same bit loop.
+inline uint16_t crc16Update(uint16_t crc, uint8_t data) {
+#ifdef __AVR__
+    return _crc16_update(crc, data);
+#else
+    crc ^= data;
+    for (uint8_t i = 0; i < 8; i++) {
+        crc = crc & 1 ? (crc >> 1) ^ 0xA001 : crc >> 1;
+    }
+    return crc;
+#endif
+}
+
+inline uint16_t crc16(const uint8_t* data, uint8_t length) {
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < length; i++) {
+        crc = crc16Update(crc, data[i]);
+    }
+    return crc;
+}
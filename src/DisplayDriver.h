@@ -0,0 +1,23 @@
+// src/DisplayDriver.h
+#pragma once
+#include "Config.h"
+
+// Selects the display backend at compile time. Every backend provides the
+// same small interface, used by DisplayManager with no virtual calls:
+//   COLS, ROWS, HAS_CGRAM   geometry and whether glyph changes show on
+//                           cells already drawn
+//   begin()                 blocking init, leaves the display blank
+//   setCursor(), write()    queue one operation; false when full
+//   createChar()            define glyph 0-7 from 5x8 row bitmaps
+//   room(), idle()          operations that fit now; all sent
+#if DISPLAY_BACKEND == DISPLAY_SSD1306
+#include "Ssd1306Text.h"
+typedef Ssd1306Text DisplayDriver;
+#define DISPLAY_ADDRESS OLED_ADDRESS
+#elif DISPLAY_BACKEND == DISPLAY_HD44780
+#include "Hd44780.h"
+typedef CharLcd<LCD_COLS, LCD_ROWS> DisplayDriver;
+#define DISPLAY_ADDRESS LCD_ADDRESS
+#else
+#error "Unknown DISPLAY_BACKEND"
+#endif
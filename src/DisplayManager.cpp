@@ -1,46 +1,455 @@
 // src/DisplayManager.cpp
 #include "DisplayManager.h"
 #include "Config.h"
+#include "FixedPoint.h"
+#include "TwiMaster.h"
+#include "Perf.h"
 
-DisplayManager::DisplayManager(SystemState& state) : _state(state), _lcd(LCD_ADDRESS, LCD_COLS, LCD_ROWS) {}
+DisplayManager::DisplayManager(SystemState& state, const ReadingStats& stats)
+    : _state(state), _stats(stats), _display(DISPLAY_ADDRESS) {}
 
 void DisplayManager::begin() {
-    _lcd.init();
-    _lcd.backlight();
+    _display.begin();  // Clears the display: _shadow starts out blank to match
+#if PAGE_BUTTON_PIN >= 0
+    pinMode(PAGE_BUTTON_PIN, INPUT_PULLUP);
+#endif
 }
 
 void DisplayManager::showWelcomeMessage() {
-    _lcd.clear();
-    _lcd.setCursor(0, 0);
-    _lcd.print("Algae Cooling System");
-    _lcd.setCursor(0, 1);
-    _lcd.print("Starting...");
+    _frame.clear();
+    _frame.setCursor(0, 0);
+    if (COLS >= 20) {
+        _frame.print(F("Algae Cooling System"));
+    } else {
+        _frame.print(F("Algae Cooling"));
+    }
+    _frame.setCursor(0, 1);
+    _frame.print(F("Starting..."));
+    startFrame();
+    // Give up on a bus error rather than retry forever without a display
+    while (_sending && TwiMaster::errors() == _busErrors) {
+        poll();
+        TwiMaster::poll();
+    }
 }
 
 void DisplayManager::update() {
-    _lcd.clear();
-    
-    // Line 1: Room Temperature
-    _lcd.setCursor(0, 0);
-    _lcd.print("Room:");
-    _lcd.setCursor(6, 0);
-    if (_state.roomTemp >= 0 && _state.roomTemp < 150) {
-        _lcd.print(_state.roomTemp, 1);
-        _lcd.print((char)223);  // Degree symbol
-        _lcd.print("C");
+    PerfScope perf(PERF_DISPLAY_UPDATE);
+    render();
+}
+
+void DisplayManager::showPage(uint8_t page) {
+    _page = page % PAGE_COUNT;
+    _pageShownMs = millis();
+    render();
+}
+
+void DisplayManager::setAutoRotate(bool enabled) {
+    _autoRotate = enabled;
+    _pageShownMs = millis();
+}
+
+uint8_t DisplayManager::page() const {
+    return _page;
+}
+
+bool DisplayManager::autoRotate() const {
+    return _autoRotate;
+}
+
+void DisplayManager::render() {
+    _frame.clear();
+    _glyphCheck = 0;
+    switch (_page) {
+        case PAGE_DELTA:  renderDelta(); break;
+        case PAGE_RANGE:  renderRange(); break;
+        case PAGE_RATE:   renderRate(); break;
+        case PAGE_FAULTS: renderFaults(); break;
+        case PAGE_TREND:  renderTrend(); break;
+        default:          renderTemps(); break;
+    }
+    if (ROWS >= 4) {
+        renderExtraRows();
+    }
+    startFrame();
+}
+
+void DisplayManager::renderTemps() {
+    printTemp(0, F("Room:"), _state.roomTemp, _state.roomFault);
+    printTemp(1, F("Algae:"), _state.algaeTemp, _state.algaeFault);
+}
+
+// Rows 3-4 on taller displays: humidity and where the rotation is
+void DisplayManager::renderExtraRows() {
+    _frame.setCursor(0, 2);
+    if (_state.humidityValid) {
+        _frame.print(F("RH "));
+        printCenti(_frame, _state.humidity, 0);
+        _frame.print(F("% Dew "));
+        printCenti(_frame, _state.dewPoint, 1);
+        _frame.print((char)223);
+    }
+    _frame.setCursor(0, 3);
+    _frame.print(F("Page "));
+    _frame.print(_page + 1);
+    _frame.print('/');
+    _frame.print(PAGE_COUNT);
+    if (!_autoRotate) {
+        _frame.print(F(" hold"));
+    }
+}
+
+// Room minus algae now, and its session range
+void DisplayManager::renderDelta() {
+    _frame.setCursor(0, 0);
+    _frame.print(F("Delta:"));
+    _frame.setCursor(7, 0);
+    if (_state.roomFault == FAULT_NONE && _state.algaeFault == FAULT_NONE) {
+        printSigned(_state.roomTemp - _state.algaeTemp, 1);
+        _frame.print((char)223);
+        _frame.print('C');
     } else {
-        _lcd.print("ERROR");
-    }
-    
-    // Line 2: Algae Temperature
-    _lcd.setCursor(0, 1);
-    _lcd.print("Algae:");
-    _lcd.setCursor(6, 1);
-    if (_state.algaeTemp >= 0 && _state.algaeTemp < 150) {
-        _lcd.print(_state.algaeTemp, 1);
-        _lcd.print((char)223);  // Degree symbol
-        _lcd.print("C");
+        _frame.print(F("--"));
+    }
+    _frame.setCursor(0, 1);
+    if (_stats.hasDelta()) {
+        printSigned(_stats.deltaMin(), 1);
+        _frame.print(F(" to "));
+        printSigned(_stats.deltaMax(), 1);
+    }
+}
+
+// Session low/high per role
+void DisplayManager::renderRange() {
+    const ReadingStats::RoleStats* roles[] = { &_stats.room(), &_stats.algae() };
+    for (uint8_t row = 0; row < 2; row++) {
+        _frame.setCursor(0, row);
+        _frame.print(row == 0 ? F("Room") : F("Algae"));
+        _frame.setCursor(6, row);
+        if (roles[row]->seen) {
+            printCenti(_frame, roles[row]->min, 1);
+            _frame.print('/');
+            printCenti(_frame, roles[row]->max, 1);
+            _frame.print((char)223);
+        } else {
+            _frame.print(F("--"));
+        }
+    }
+}
+
+// Smoothed trend, degrees per minute
+void DisplayManager::renderRate() {
+    const ReadingStats::RoleStats* roles[] = { &_stats.room(), &_stats.algae() };
+    for (uint8_t row = 0; row < 2; row++) {
+        _frame.setCursor(0, row);
+        _frame.print(row == 0 ? F("Room") : F("Algae"));
+        _frame.setCursor(6, row);
+        printSigned(roles[row]->rate, 2);
+        _frame.print((char)223);
+        _frame.print(F("/m"));
+    }
+}
+
+// Current state and how many readings arrived faulted this session
+void DisplayManager::renderFaults() {
+    SensorFault faults[] = { _state.roomFault, _state.algaeFault };
+    const ReadingStats::RoleStats* roles[] = { &_stats.room(), &_stats.algae() };
+    for (uint8_t row = 0; row < 2; row++) {
+        _frame.setCursor(0, row);
+        _frame.print(row == 0 ? F("Room:") : F("Algae:"));
+        _frame.setCursor(7, row);
+        _frame.print(faultName(faults[row]));
+        _frame.setCursor(12, row);
+        _frame.print(min(roles[row]->faults, (uint16_t)9999));
+    }
+}
+
+// Line 1: role, current reading and top of scale; line 2: the sparkline
+// (glyphs 0-7, oldest-column gap marks the sweep position) and bottom of scale
+void DisplayManager::renderTrend() {
+    const TrendHistory& history = _stats.history();
+    bool room = _trendRole == ROLE_ROOM;
+    uint8_t lo = 255;
+    uint8_t hi = 0;
+    for (uint8_t i = 0; i < TrendHistory::LENGTH; i++) {
+        uint8_t code = room ? history.room(i) : history.algae(i);
+        if (code != TrendHistory::NO_DATA) {
+            lo = min(lo, code);
+            hi = max(hi, code);
+        }
+    }
+    if (hi != 0) {
+        updateScale(lo, hi);
+    }
+
+    printTemp(0, room ? F("Room") : F("Algae"), room ? _state.roomTemp : _state.algaeTemp,
+              room ? _state.roomFault : _state.algaeFault);
+    _frame.setCursor(0, 1);
+    for (uint8_t g = 0; g < GLYPHS; g++) {
+        _frame.write(g);
+    }
+    if (hi != 0) {
+        _frame.setCursor(13, 0);
+        printCenti(_frame, TrendHistory::decode(_scaleHi), 0);
+        _frame.print((char)223);
+        _frame.setCursor(13, 1);
+        printCenti(_frame, TrendHistory::decode(_scaleLo), 0);
+        _frame.print((char)223);
+    }
+    _glyphCheck = 0xFF;
+}
+
+// Whole-degree scale that only moves when a sample leaves it or the data
+// has shrunk to under half of it; every move redraws all eight glyphs
+void DisplayManager::updateScale(uint8_t lo, uint8_t hi) {
+    uint8_t span = max(hi - lo, 4);
+    if (lo >= _scaleLo && hi <= _scaleHi && _scaleHi - _scaleLo <= 2 * span) {
+        return;
+    }
+    // Code multiples of 4 are whole degrees; the top of the code range
+    // still leaves a 4-code span below 252
+    _scaleLo = min(lo & ~3, 248);
+    _scaleHi = min((hi + 3) & ~3, 252);
+    if (_scaleHi <= _scaleLo) {
+        _scaleHi = _scaleLo + 4;
+    }
+}
+
+void DisplayManager::buildGlyph(uint8_t glyph, uint8_t* rows) const {
+    const TrendHistory& history = _stats.history();
+    memset(rows, 0, 8);
+    for (uint8_t x = 0; x < GLYPH_COLUMNS; x++) {
+        uint8_t slot = glyph * GLYPH_COLUMNS + x;
+        uint8_t code = _trendRole == ROLE_ROOM ? history.room(slot) : history.algae(slot);
+        if (slot == history.head() || code == TrendHistory::NO_DATA) {
+            continue;
+        }
+        code = constrain(code, _scaleLo, _scaleHi);
+        uint8_t height = (uint16_t)(code - _scaleLo) * 7 / (_scaleHi - _scaleLo);
+        for (uint8_t row = 7 - height; row < 8; row++) {
+            rows[row] |= 0x10 >> x;
+        }
+    }
+}
+
+// Uploads at most one changed glyph per pass; true while any are unchecked
+bool DisplayManager::pollGlyphs() {
+    while (_glyphCheck) {
+        uint8_t glyph = 0;
+        while (!(_glyphCheck & (1 << glyph))) {
+            glyph++;
+        }
+        uint8_t rows[8];
+        buildGlyph(glyph, rows);
+        if ((_glyphValid & (1 << glyph)) && memcmp(rows, _glyphs[glyph], 8) == 0) {
+            _glyphCheck &= ~(1 << glyph);
+            continue;
+        }
+        if (!_display.createChar(glyph, rows)) {
+            return true;  // Queue full; retry next pass
+        }
+        memcpy(_glyphs[glyph], rows, 8);
+        _glyphValid |= 1 << glyph;
+        _glyphCheck &= ~(1 << glyph);
+        _glyphUploads++;
+        _frameWrites++;
+        _cursorHere = false;  // HD44780 address counter now points into CGRAM
+        if (!DisplayDriver::HAS_CGRAM) {
+            invalidateGlyph(glyph);
+        }
+        break;
+    }
+    return _glyphCheck != 0;
+}
+
+// Without CGRAM, cells already showing the glyph keep the old bitmap until
+// they are written again: mark them stale and rescan the frame
+void DisplayManager::invalidateGlyph(uint8_t glyph) {
+    for (uint8_t row = 0; row < ROWS; row++) {
+        for (uint8_t col = 0; col < COLS; col++) {
+            if (_shadow.at(col, row) == (char)glyph) {
+                _shadow.set(col, row, (char)0xFF);
+            }
+        }
+    }
+    _scanCol = 0;
+    _scanRow = 0;
+}
+
+void DisplayManager::setTrendRole(ChannelRole role) {
+    _trendRole = role;
+}
+
+void DisplayManager::printTemp(uint8_t row, const __FlashStringHelper* label, centi_t value,
+                               SensorFault fault) {
+    _frame.setCursor(0, row);
+    _frame.print(label);
+    _frame.setCursor(6, row);
+    if (fault == FAULT_NONE) {
+        printCenti(_frame, value, 1);
+        _frame.print((char)223);  // Degree symbol
+        _frame.print('C');
     } else {
-        _lcd.print("ERROR");
+        _frame.print(faultName(fault));
+    }
+}
+
+void DisplayManager::printSigned(centi_t value, uint8_t decimals) {
+    if (value >= 0) {
+        _frame.print('+');
+    }
+    printCenti(_frame, value, decimals);
+}
+
+void DisplayManager::startFrame() {
+    _sending = true;
+    _cursorHere = false;
+    _scanCol = 0;
+    _scanRow = 0;
+    _frameWrites = 0;
+    _frameStartBytes = TwiMaster::streamBytes();
+    _frameStartUs = micros();
+}
+
+// Cells and glyphs queued before the error may never have arrived, so
+// _shadow no longer says what is shown: mark every cell stale (0xFF is
+// never drawn) and every glyph unknown, then render the page again.
+// True while the display waits for a resync.
+bool DisplayManager::pollResync() {
+    uint16_t errors = TwiMaster::errors();
+    if (errors == _busErrors) {
+        return false;
+    }
+    if (millis() - _resyncMs < RESYNC_RETRY_MS || !_display.resync()) {
+        return true;
+    }
+    _busErrors = errors;
+    _resyncMs = millis();
+    _resyncs++;
+    _shadow.fill((char)0xFF);
+    _glyphValid = 0;
+    render();
+    return false;
+}
+
+// Active-low button to GND; 30 ms debounce
+void DisplayManager::pollButton() {
+#if PAGE_BUTTON_PIN >= 0
+    bool down = digitalRead(PAGE_BUTTON_PIN) == LOW;
+    if (down == _buttonDown || millis() - _buttonChangeMs < 30) {
+        return;
+    }
+    _buttonDown = down;
+    _buttonChangeMs = millis();
+    if (down) {
+        showPage(_page + 1);
+    }
+#endif
+}
+
+void DisplayManager::poll() {
+    pollButton();
+    if (_autoRotate && millis() - _pageShownMs >= PAGE_ROTATE_MS) {
+        showPage(_page + 1);
+    }
+    if (pollResync() || !_sending) {
+        return;
     }
+    unsigned long start = micros();
+    bool glyphsPending = pollGlyphs();
+    uint8_t budget = min(_display.room(), (uint8_t)LCD_BYTES_PER_POLL);
+    while (_scanRow < ROWS) {
+        char c = _frame.at(_scanCol, _scanRow);
+        if (c != _shadow.at(_scanCol, _scanRow)) {
+            uint8_t needed = _cursorHere ? 1 : 2;
+            if (needed > budget) {
+                break;  // Resume from this cell on the next pass
+            }
+            if (!_cursorHere) {
+                _display.setCursor(_scanCol, _scanRow);
+            }
+            _display.write(c);  // Address auto-increments
+            _shadow.set(_scanCol, _scanRow, c);
+            budget -= needed;
+            _frameWrites += needed;
+            _cursorHere = true;
+        } else {
+            _cursorHere = false;
+        }
+        if (++_scanCol == COLS) {
+            _scanCol = 0;
+            _scanRow++;
+            _cursorHere = false;
+        }
+    }
+    uint16_t elapsed = micros() - start;
+    _maxPollUs = max(_maxPollUs, elapsed);
+
+    if (_scanRow == ROWS && !glyphsPending && _display.idle()) {
+        finishFrame();
+    }
+}
+
+void DisplayManager::finishFrame() {
+    _sending = false;
+    uint16_t wireBytes = TwiMaster::streamBytes() - _frameStartBytes;
+    uint32_t latency = micros() - _frameStartUs;
+
+    _frames++;
+    _lastWrites = _frameWrites;
+    _maxWrites = max(_maxWrites, _frameWrites);
+    _totalWrites += _frameWrites;
+    _lastWireBytes = wireBytes;
+    _maxWireBytes = max(_maxWireBytes, wireBytes);
+    _lastLatencyUs = latency;
+    _maxLatencyUs = max(_maxLatencyUs, latency);
+}
+
+void DisplayManager::printStats() {
+    Serial.println(F("\n=== Display ==="));
+    Serial.print(F("Size: "));
+    Serial.print(COLS);
+    Serial.print('x');
+    Serial.println(ROWS);
+    Serial.print(F("Frames: "));
+    Serial.println(_frames);
+    Serial.print(F("Writes/frame: last "));
+    Serial.print(_lastWrites);
+    Serial.print(F(", max "));
+    Serial.print(_maxWrites);
+    Serial.print(F(", avg "));
+    Serial.print(_frames ? _totalWrites / _frames : 0);
+    Serial.print(F(" (full redraw "));
+    Serial.print(ROWS * (COLS + 1) + 1);  // clear + setCursor + cells per row
+    Serial.println(F(")"));
+    Serial.print(F("I2C bytes/frame: last "));
+    Serial.print(_lastWireBytes);
+    Serial.print(F(", max "));
+    Serial.println(_maxWireBytes);
+    Serial.print(F("Update to glass: last "));
+    Serial.print(_lastLatencyUs);
+    Serial.print(F(" us, max "));
+    Serial.print(_maxLatencyUs);
+    Serial.println(F(" us"));
+    Serial.print(F("Longest poll(): "));
+    Serial.print(_maxPollUs);
+    Serial.println(F(" us"));
+    Serial.print(F("Glyph uploads: "));
+    Serial.println(_glyphUploads);
+    Serial.print(F("I2C errors: "));
+    Serial.print(TwiMaster::errors());
+    Serial.print(F(", resyncs: "));
+    Serial.println(_resyncs);
+    Serial.println(F("===============\n"));
+}
+
+void DisplayManager::resetStats() {
+    _frames = 0;
+    _lastWrites = _maxWrites = 0;
+    _totalWrites = 0;
+    _lastWireBytes = _maxWireBytes = 0;
+    _lastLatencyUs = _maxLatencyUs = 0;
+    _maxPollUs = 0;
+    _glyphUploads = 0;
+    _resyncs = 0;
 }
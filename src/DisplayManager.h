@@ -1,15 +1,118 @@
 // src/DisplayManager.h
 #pragma once
-#include <LiquidCrystal_I2C.h>
 #include "State.h"
+#include "TextFrame.h"
+#include "DisplayDriver.h"
+#include "ReadingStats.h"
 
+// Pages are drawn into _frame; poll() compares it with _shadow (what the
+// display shows or has queued) and queues only the cells that differ, moving the
+// cursor only where a run of changes is interrupted. Each poll() queues at
+// most LCD_BYTES_PER_POLL operations and resumes the scan where it stopped, so a
+// full redraw is spread over several loop() passes while TWI_vect puts the
+// bytes on the wire. No clear(), so no blank-and-redraw flicker.
+// Pages rotate every PAGE_ROTATE_MS or step on a PAGE_BUTTON_PIN press; all
+// are drawn from ReadingStats aggregates, so a page costs one render. The
+// trend page draws TrendHistory as a sparkline in the 8 user glyphs; a
+// glyph is re-uploaded only when its bitmap differs from the last copy.
+// When TwiMaster::errors() moves, queued display bytes were dropped and the
+// controller may be out of step: poll() resyncs it and redraws every cell
+// and glyph, at most once per RESYNC_RETRY_MS so an absent display is not
+// hammered.
+// The backend (DisplayDriver) fixes COLS x ROWS at compile time; pages use
+// the top 16x2 and displays with four or more rows get two extra lines.
 class DisplayManager {
 public:
-    DisplayManager(SystemState& state);
+    enum Page : uint8_t {
+        PAGE_TEMPS, PAGE_DELTA, PAGE_RANGE, PAGE_RATE, PAGE_FAULTS, PAGE_TREND, PAGE_COUNT
+    };
+
+    DisplayManager(SystemState& state, const ReadingStats& stats);
     void begin();
     void showWelcomeMessage();
+    // Renders the current page with the new reading; poll() sends it
     void update();
+    // Call every loop()
+    void poll();
+    void showPage(uint8_t page);
+    void setAutoRotate(bool enabled);
+    uint8_t page() const;
+    bool autoRotate() const;
+    void setTrendRole(ChannelRole role);
+    void printStats();
+    void resetStats();
+    static const uint8_t COLS = DisplayDriver::COLS;
+    static const uint8_t ROWS = DisplayDriver::ROWS;
+    static_assert(COLS >= 16 && ROWS >= 2, "Pages are laid out for 16x2");
 private:
+    static const uint8_t GLYPHS = 8;
+    static const uint8_t GLYPH_COLUMNS = 5;
+    static const uint16_t RESYNC_RETRY_MS = 500;
+    static_assert(TrendHistory::LENGTH == GLYPHS * GLYPH_COLUMNS, "One history slot per pixel column");
+
     SystemState& _state;
-    LiquidCrystal_I2C _lcd;
+    const ReadingStats& _stats;
+    DisplayDriver _display;
+    TextFrame<COLS, ROWS> _frame;
+    TextFrame<COLS, ROWS> _shadow;
+
+    uint8_t _page = PAGE_TEMPS;
+    bool _autoRotate = true;
+    unsigned long _pageShownMs = 0;
+    bool _buttonDown = false;
+    unsigned long _buttonChangeMs = 0;
+
+    // Sparkline: codes (TrendHistory units) at the bottom and top pixel rows
+    ChannelRole _trendRole = ROLE_ALGAE;
+    uint8_t _scaleLo = 0;
+    uint8_t _scaleHi = 0;
+    uint8_t _glyphs[GLYPHS][8];  // As uploaded to the display
+    uint8_t _glyphValid = 0;     // Bit per glyph: _glyphs matches the display
+    uint8_t _glyphCheck = 0;     // Bit per glyph: compare before finishing
+    uint16_t _glyphUploads = 0;
+
+    uint16_t _busErrors = 0;  // TwiMaster::errors() as of the last resync
+    unsigned long _resyncMs = 0;
+    uint16_t _resyncs = 0;
+
+    // Diff scan position; _scanRow == ROWS once the frame is queued
+    bool _sending = false;
+    bool _cursorHere = false;
+    uint8_t _scanCol = 0;
+    uint8_t _scanRow = ROWS;
+    uint16_t _frameWrites = 0;
+    uint32_t _frameStartBytes = 0;
+    unsigned long _frameStartUs = 0;
+
+    // Stats per frame: display operations queued (setCursor, write or glyph
+    // upload), I2C bytes on the wire (address bytes included), update() to
+    // last byte sent, and the longest poll()
+    uint16_t _frames = 0;
+    uint16_t _lastWrites = 0;
+    uint16_t _maxWrites = 0;
+    uint32_t _totalWrites = 0;
+    uint16_t _lastWireBytes = 0;
+    uint16_t _maxWireBytes = 0;
+    uint32_t _lastLatencyUs = 0;
+    uint32_t _maxLatencyUs = 0;
+    uint16_t _maxPollUs = 0;
+
+    void render();
+    void renderTemps();
+    void renderDelta();
+    void renderRange();
+    void renderRate();
+    void renderFaults();
+    void renderTrend();
+    void renderExtraRows();
+    void updateScale(uint8_t lo, uint8_t hi);
+    void buildGlyph(uint8_t glyph, uint8_t* rows) const;
+    bool pollGlyphs();
+    void invalidateGlyph(uint8_t glyph);
+    void printTemp(uint8_t row, const __FlashStringHelper* label, centi_t value, SensorFault fault);
+    void printSigned(centi_t value, uint8_t decimals);
+    void pollButton();
+    bool pollResync();
+    void startFrame();
+    void finishFrame();
 };
@@ -0,0 +1,199 @@
+// src/Ds18b20Bus.cpp
+#include "Ds18b20Bus.h"
+
+#if ENABLE_DS18B20
+#include <Arduino.h>
+
+static const uint8_t FAMILY_DS18B20 = 0x28;
+static const uint8_t CMD_CONVERT_T = 0x44;
+static const uint8_t CMD_READ_SCRATCHPAD = 0xBE;
+static const uint8_t CMD_MATCH_ROM = 0x55;
+static const uint8_t CMD_SKIP_ROM = 0xCC;
+static const int16_t POWER_ON_RAW = 0x0550;  // 85 C: conversion never ran
+
+static const ChannelRole DEFAULT_ROLES[] = { DS18B20_DEFAULT_ROLES };
+
+Ds18b20Bus::Ds18b20Bus(uint8_t pin) : _bus(pin) {}
+
+uint8_t Ds18b20Bus::discover() {
+    _count = 0;
+    _phase = PHASE_IDLE;
+    _bus.reset_search();
+    uint8_t rom[8];
+    while (_count < MAX_PROBES && _bus.search(rom)) {
+        if (rom[0] != FAMILY_DS18B20 || OneWire::crc8(rom, 7) != rom[7]) {
+            continue;
+        }
+        memcpy(_roms[_count], rom, 8);
+        _roles[_count] = _count < sizeof(DEFAULT_ROLES) / sizeof(DEFAULT_ROLES[0])
+                       ? DEFAULT_ROLES[_count] : ROLE_AUX;
+        _temp[_count] = 0;
+        _fault[_count] = FAULT_OPEN;  // Until the first good read
+        _count++;
+    }
+    return _count;
+}
+
+void Ds18b20Bus::startConversion() {
+    if (_count == 0) {
+        return;
+    }
+    if (_phase != PHASE_IDLE) {
+        _pending = true;  // Start again once the current cycle is read out
+        return;
+    }
+    _phase = PHASE_CONVERT;
+    _step = 0;
+}
+
+void Ds18b20Bus::poll() {
+    switch (_phase) {
+        case PHASE_CONVERT:
+            pollConvert();
+            break;
+        case PHASE_WAIT:
+            if (millis() - _convertStartMs >= DS18B20_CONVERSION_MS) {
+                _phase = PHASE_READ;
+                _probe = 0;
+                _step = 0;
+            }
+            break;
+        case PHASE_READ:
+            pollRead();
+            break;
+        default:
+            if (_pending) {
+                _pending = false;
+                startConversion();
+            }
+            break;
+    }
+}
+
+// reset, SKIP ROM, CONVERT T (strong pull-up held for parasite-powered probes)
+void Ds18b20Bus::pollConvert() {
+    switch (_step++) {
+        case 0:
+            if (!_bus.reset()) {
+                for (uint8_t i = 0; i < _count; i++) {
+                    _fault[i] = FAULT_OPEN;
+                }
+                _phase = PHASE_IDLE;
+            }
+            break;
+        case 1:
+            _bus.write(CMD_SKIP_ROM);
+            break;
+        default:
+            _bus.write(CMD_CONVERT_T, 1);
+            _convertStartMs = millis();
+            _phase = PHASE_WAIT;
+            break;
+    }
+}
+
+// reset, MATCH ROM + 8 ROM bytes, READ SCRATCHPAD, then 9 data bytes
+void Ds18b20Bus::pollRead() {
+    uint8_t step = _step++;
+    if (step == 0) {
+        _bus.depower();
+        if (!_bus.reset()) {
+            _fault[_probe] = FAULT_OPEN;
+            _step = 0;
+            if (++_probe >= _count) {
+                _phase = PHASE_IDLE;
+            }
+        }
+    } else if (step == 1) {
+        _bus.write(CMD_MATCH_ROM);
+    } else if (step <= 9) {
+        _bus.write(_roms[_probe][step - 2]);
+    } else if (step == 10) {
+        _bus.write(CMD_READ_SCRATCHPAD);
+    } else {
+        _scratchpad[step - 11] = _bus.read();
+        if (step == 19) {
+            finishProbe();
+        }
+    }
+}
+
+void Ds18b20Bus::finishProbe() {
+    int16_t raw = (int16_t)((_scratchpad[1] << 8) | _scratchpad[0]);
+    if (OneWire::crc8(_scratchpad, 8) != _scratchpad[8] || raw == POWER_ON_RAW) {
+        _fault[_probe] = FAULT_COMM;
+    } else {
+        _temp[_probe] = ((int32_t)raw * 25) / 4;  // 1/16 C -> 1/100 C
+        _fault[_probe] = FAULT_NONE;
+    }
+    _step = 0;
+    if (++_probe >= _count) {
+        _phase = PHASE_IDLE;
+    }
+}
+
+uint8_t Ds18b20Bus::probeCount() const {
+    return _count;
+}
+
+void Ds18b20Bus::assign(uint8_t probe, ChannelRole role) {
+    if (probe >= _count) {
+        return;
+    }
+    // A role belongs to one probe at a time
+    if (role != ROLE_AUX) {
+        for (uint8_t i = 0; i < _count; i++) {
+            if (_roles[i] == role) {
+                _roles[i] = ROLE_AUX;
+            }
+        }
+    }
+    _roles[probe] = role;
+}
+
+int8_t Ds18b20Bus::probeForRole(ChannelRole role) const {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_roles[i] == role) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+centi_t Ds18b20Bus::temperature(uint8_t probe) const {
+    return _temp[probe];
+}
+
+SensorFault Ds18b20Bus::fault(uint8_t probe) const {
+    return _fault[probe];
+}
+
+void Ds18b20Bus::printProbes(Print& out) const {
+    if (_count == 0) {
+        out.println(F("No DS18B20 probes found"));
+        return;
+    }
+    for (uint8_t i = 0; i < _count; i++) {
+        out.print(i);
+        out.print(F(": "));
+        for (uint8_t b = 0; b < 8; b++) {
+            if (_roms[i][b] < 16) out.print('0');
+            out.print(_roms[i][b], HEX);
+        }
+        out.print(F(" -> "));
+        switch (_roles[i]) {
+            case ROLE_ROOM:  out.print(F("room")); break;
+            case ROLE_ALGAE: out.print(F("algae")); break;
+            default:         out.print(F("unassigned")); break;
+        }
+        out.print(F(", "));
+        if (_fault[i] == FAULT_NONE) {
+            printCenti(out, _temp[i], 2);
+            out.println(F("°C"));
+        } else {
+            out.println(faultName(_fault[i]));
+        }
+    }
+}
+
+#endif  // ENABLE_DS18B20
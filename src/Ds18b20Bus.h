@@ -0,0 +1,56 @@
+// src/Ds18b20Bus.h
+#pragma once
+#include <stdint.h>
+#include "Config.h"
+
+#if ENABLE_DS18B20
+#include <OneWire.h>
+#include "ChannelTable.h"
+#include "FaultDetector.h"
+
+// DS18B20 probes on one OneWire bus. A conversion is started on every probe at
+// once (skip ROM), then each scratchpad is read back by ROM after the 750 ms
+// conversion time. poll() performs a single reset or byte transfer per call
+// (at most ~1 ms with interrupts briefly off per bit), so the bus never holds
+// up loop() the way the usual blocking library calls do.
+class Ds18b20Bus {
+public:
+    static const uint8_t MAX_PROBES = 4;
+
+    Ds18b20Bus(uint8_t pin);
+    // Blocking ROM search; for setup() and interactive commands only
+    uint8_t discover();
+    void startConversion();
+    void poll();
+
+    uint8_t probeCount() const;
+    void assign(uint8_t probe, ChannelRole role);
+    // Index of the probe holding a role, or -1
+    int8_t probeForRole(ChannelRole role) const;
+    centi_t temperature(uint8_t probe) const;
+    SensorFault fault(uint8_t probe) const;
+    void printProbes(Print& out) const;
+
+private:
+    enum Phase : uint8_t { PHASE_IDLE, PHASE_CONVERT, PHASE_WAIT, PHASE_READ };
+
+    OneWire _bus;
+    uint8_t _count = 0;
+    uint8_t _roms[MAX_PROBES][8];
+    ChannelRole _roles[MAX_PROBES];
+    centi_t _temp[MAX_PROBES];
+    SensorFault _fault[MAX_PROBES];
+
+    Phase _phase = PHASE_IDLE;
+    bool _pending = false;
+    uint8_t _step = 0;
+    uint8_t _probe = 0;
+    uint8_t _scratchpad[9];
+    unsigned long _convertStartMs = 0;
+
+    void pollConvert();
+    void pollRead();
+    void finishProbe();
+};
+
+#endif  // ENABLE_DS18B20
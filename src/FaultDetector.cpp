@@ -0,0 +1,63 @@
+// src/FaultDetector.cpp
+#include "FaultDetector.h"
+#include "Config.h"
+#include <Arduino.h>
+
+SensorFault FaultDetector::check(uint16_t minRaw, uint16_t maxRaw, uint16_t code,
+                                 centi_t reading, uint16_t stepCenti, uint16_t refMillivolts,
+                                 unsigned long nowMs) {
+    // Raw conversions are 10-bit: mV = counts * Vref / 1024
+    uint16_t maxMv = ((uint32_t)maxRaw * refMillivolts) >> 10;
+    uint16_t spreadMv = ((uint32_t)(maxRaw - minRaw) * refMillivolts) >> 10;
+
+    // A healthy LM35 in still water can hold one code for minutes (0.49 C
+    // per 10-bit LSB, little ADC noise), so only hours of it count
+    bool stuck = _primed && minRaw == maxRaw && code == _lastCode;
+    if (!stuck) {
+        _stuckSinceMs = nowMs;
+    }
+    _lastCode = code;
+
+    // A code or two of flicker is ~100 centi at 10 bits, as much as
+    // FAULT_MAX_SLEW allows in 500 ms, so it comes off before comparing
+    unsigned long elapsedMs = nowMs - _lastMs;
+    int32_t change = abs((int32_t)reading - _lastReading) - (int32_t)stepCenti * FAULT_SLEW_CODES;
+    bool slewing = _primed && change > 0
+        && (uint32_t)change * 1000UL > (uint32_t)FAULT_MAX_SLEW * elapsedMs;
+    _primed = true;
+    _lastReading = reading;
+    _lastMs = nowMs;
+
+    if (maxRaw >= 1022) {
+        return FAULT_SATURATED;
+    }
+    if (maxMv <= FAULT_OPEN_MV) {
+        return FAULT_OPEN;
+    }
+    if (reading > FAULT_MAX_TEMP) {
+        return FAULT_RANGE;
+    }
+    if (spreadMv > FAULT_MAX_SPREAD_MV) {
+        return FAULT_NOISY;
+    }
+    if (slewing) {
+        return FAULT_SLEW;
+    }
+    if (nowMs - _stuckSinceMs >= FAULT_STUCK_MINUTES * 60000UL) {
+        return FAULT_STUCK;
+    }
+    return FAULT_NONE;
+}
+
+const __FlashStringHelper* faultName(SensorFault fault) {
+    switch (fault) {
+        case FAULT_OPEN:      return F("OPEN");
+        case FAULT_SATURATED: return F("RAIL");
+        case FAULT_RANGE:     return F("RANGE");
+        case FAULT_NOISY:     return F("NOISY");
+        case FAULT_SLEW:      return F("SLEW");
+        case FAULT_STUCK:     return F("STUCK");
+        case FAULT_COMM:      return F("COMM");
+        default:              return F("OK");
+    }
+}
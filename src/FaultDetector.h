@@ -0,0 +1,37 @@
+// src/FaultDetector.h
+#pragma once
+#include <stdint.h>
+#include "FixedPoint.h"
+
+class __FlashStringHelper;
+
+enum SensorFault : uint8_t {
+    FAULT_NONE,
+    FAULT_OPEN,       // Output at ~0 V: disconnected signal wire
+    FAULT_SATURATED,  // ADC at full scale: VCC/GND swapped or over-range
+    FAULT_RANGE,      // Beyond FAULT_MAX_TEMP: wiring fault
+    FAULT_NOISY,      // Spread within one window no real sensor produces
+    FAULT_SLEW,       // Faster change between windows than air can manage
+    FAULT_STUCK,      // Identical, noise-free codes for many windows
+    FAULT_COMM        // Digital sensor: bad CRC or no conversion result
+};
+
+// Classifies a channel from statistics the sampling window already gathers
+// (min/max raw conversion, decimated code), so it costs no extra conversions.
+// Reversed sensors (~49 C) look like a genuine hot reading and are not flagged.
+class FaultDetector {
+public:
+    // stepCenti is one decimated code in centi-degrees; FAULT_SLEW_CODES of
+    // them between windows are quantisation flicker, not slew
+    SensorFault check(uint16_t minRaw, uint16_t maxRaw, uint16_t code,
+                      centi_t reading, uint16_t stepCenti, uint16_t refMillivolts,
+                      unsigned long nowMs);
+private:
+    bool _primed = false;
+    centi_t _lastReading = 0;
+    unsigned long _lastMs = 0;
+    uint16_t _lastCode = 0;
+    unsigned long _stuckSinceMs = 0;
+};
+
+const __FlashStringHelper* faultName(SensorFault fault);
@@ -0,0 +1,95 @@
+// src/FixedPoint.cpp
+#include "FixedPoint.h"
+#include <Arduino.h>
+
+uint8_t formatCenti(char* buf, centi_t value, uint8_t decimals) {
+    uint16_t mag = value < 0 ? -(int32_t)value : value;
+    if (decimals == 0) {
+        mag = (mag + 50) / 100;
+    } else if (decimals == 1) {
+        mag = (mag + 5) / 10;
+    } else {
+        decimals = 2;
+    }
+
+    // Digits come out least significant first
+    char tmp[7];
+    uint8_t n = 0;
+    uint8_t digits = 0;
+    do {
+        tmp[n++] = '0' + mag % 10;
+        mag /= 10;
+        if (++digits == decimals) {
+            tmp[n++] = '.';
+        }
+    } while (mag || digits <= decimals);
+
+    uint8_t len = 0;
+    bool isZero = true;
+    for (uint8_t i = 0; i < n; i++) {
+        if (tmp[i] != '0' && tmp[i] != '.') {
+            isZero = false;
+        }
+    }
+    if (value < 0 && !isZero) {
+        buf[len++] = '-';
+    }
+    while (n) {
+        buf[len++] = tmp[--n];
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+void printCenti(Print& out, centi_t value, uint8_t decimals) {
+    char buf[8];
+    formatCenti(buf, value, decimals);
+    out.print(buf);
+}
+
+void printPadded(Print& out, uint32_t value, uint8_t width) {
+    char digits[11];
+    ultoa(value, digits, 10);
+    for (uint8_t pad = strlen(digits); pad < width; pad++) {
+        out.print(' ');
+    }
+    out.print(digits);
+}
+
+bool parseCenti(const char* text, centi_t& value) {
+    bool negative = *text == '-';
+    if (negative) {
+        text++;
+    }
+    int32_t result = 0;
+    uint8_t digits = 0;
+    uint8_t decimals = 0;
+    bool fraction = false;
+    for (; *text; text++) {
+        if (*text == '.' && !fraction) {
+            fraction = true;
+        } else if (*text >= '0' && *text <= '9') {
+            digits++;
+            if (fraction && ++decimals > 2) {
+                continue;
+            }
+            result = result * 10 + (*text - '0');
+            if (result > 3276700L) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    if (digits == 0) {
+        return false;
+    }
+    for (; decimals < 2; decimals++) {
+        result *= 10;
+    }
+    if (result > 32767) {
+        return false;
+    }
+    value = negative ? -result : result;
+    return true;
+}
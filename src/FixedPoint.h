@@ -0,0 +1,20 @@
+// src/FixedPoint.h
+#pragma once
+#include <stdint.h>
+
+class Print;
+
+// Temperatures travel through the system as signed hundredths of a degree C
+// (e.g. 2437 = 24.37 C), so the AVR never needs software float on the hot path.
+// That is a speed measure (`bench fixed`); float code is still linked for the
+// dew point and the bench commands, so it is not a flash saving.
+typedef int16_t centi_t;
+
+// Writes value with 0-2 decimals (rounded) plus a terminator; buf needs 8 bytes.
+// Returns the number of characters written.
+uint8_t formatCenti(char* buf, centi_t value, uint8_t decimals);
+void printCenti(Print& out, centi_t value, uint8_t decimals);
+// Unsigned integer right-aligned in width characters, for report tables
+void printPadded(Print& out, uint32_t value, uint8_t width);
+// Parses "[-]123[.45]"; extra decimals are truncated. False on anything else.
+bool parseCenti(const char* text, centi_t& value);
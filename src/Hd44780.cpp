@@ -0,0 +1,133 @@
+// src/Hd44780.cpp
+#include "Hd44780.h"
+#include "TwiMaster.h"
+#include "Config.h"
+#include <Arduino.h>
+
+static const uint8_t PIN_RS = 0x01;
+static const uint8_t PIN_E = 0x04;
+static const uint8_t PIN_BACKLIGHT = 0x08;
+
+static const uint8_t CMD_CLEAR = 0x01;
+static const uint8_t CMD_ENTRY_LEFT = 0x06;
+static const uint8_t CMD_DISPLAY_ON = 0x0C;
+static const uint8_t CMD_FUNCTION_4BIT_2LINE = 0x28;
+static const uint8_t CMD_SET_CGRAM = 0x40;
+static const uint8_t CMD_SET_DDRAM = 0x80;
+
+static const uint8_t ROW_OFFSETS[] = { 0x00, 0x40, 0x14, 0x54 };
+static const uint8_t EXPANDER_BYTES_PER_LCD_BYTE = 4;
+// Expander writes with E low that cover the 1.52 ms of a clear or return
+// home, at 9 bit times each
+static const uint8_t RESYNC_PAUSE_BYTES = 1600UL * (I2C_CLOCK_HZ / 1000) / 9000 + 1;
+static const uint8_t RESYNC_BYTES = 4 * 2 + RESYNC_PAUSE_BYTES + 3 * EXPANDER_BYTES_PER_LCD_BYTE;
+static_assert(RESYNC_BYTES < TWI_STREAM_SIZE, "Resync sequence must fit the TWI stream");
+
+Hd44780::Hd44780(uint8_t address, uint8_t rows)
+    : _address(address), _rows(rows), _backlight(PIN_BACKLIGHT) {}
+
+void Hd44780::begin() {
+    TwiMaster::setStreamAddress(_address);
+    delay(50);  // Power-up wait after Vcc reaches 4.5 V
+    TwiMaster::write(_address, &_backlight, 1);
+
+    // HD44780 datasheet fig. 24: three 8-bit function sets, then 4-bit mode
+    sendNibbleBlocking(0x03, 0);
+    delayMicroseconds(4500);
+    sendNibbleBlocking(0x03, 0);
+    delayMicroseconds(4500);
+    sendNibbleBlocking(0x03, 0);
+    delayMicroseconds(150);
+    sendNibbleBlocking(0x02, 0);
+
+    commandBlocking(CMD_FUNCTION_4BIT_2LINE);
+    commandBlocking(CMD_DISPLAY_ON);
+    commandBlocking(CMD_CLEAR);
+    delayMicroseconds(2000);  // Clear takes 1.52 ms
+    commandBlocking(CMD_ENTRY_LEFT);
+}
+
+bool Hd44780::setCursor(uint8_t col, uint8_t row) {
+    if (row >= _rows) {
+        row = _rows - 1;
+    }
+    return queueByte(CMD_SET_DDRAM | (col + ROW_OFFSETS[row]), 0);
+}
+
+bool Hd44780::write(uint8_t value) {
+    return queueByte(value, PIN_RS);
+}
+
+bool Hd44780::createChar(uint8_t slot, const uint8_t* rows) {
+    if (room() < 9) {
+        return false;
+    }
+    queueByte(CMD_SET_CGRAM | (slot & 0x07) << 3, 0);
+    for (uint8_t i = 0; i < 8; i++) {
+        queueByte(rows[i], PIN_RS);
+    }
+    return true;
+}
+
+uint8_t Hd44780::room() const {
+    return TwiMaster::queueFree() / EXPANDER_BYTES_PER_LCD_BYTE;
+}
+
+bool Hd44780::idle() const {
+    return TwiMaster::streamIdle();
+}
+
+// A stream error can leave the controller holding one nibble of a byte,
+// after which every byte is read a nibble off. The first 0x3 completes any
+// such half byte, possibly as a slow command (hence the pause), then 0x3,
+// 0x3, 0x2 is the datasheet's handshake back into 4-bit mode from either
+// state. The half byte may have been any command, so mode, display and
+// entry settings are sent again.
+bool Hd44780::resync() {
+    if (TwiMaster::queueFree() < RESYNC_BYTES) {
+        return false;
+    }
+    queueNibble(0x03);
+    for (uint8_t i = 0; i < RESYNC_PAUSE_BYTES; i++) {
+        TwiMaster::queue(_backlight);
+    }
+    queueNibble(0x03);
+    queueNibble(0x03);
+    queueNibble(0x02);
+    queueByte(CMD_FUNCTION_4BIT_2LINE, 0);
+    queueByte(CMD_DISPLAY_ON, 0);
+    queueByte(CMD_ENTRY_LEFT, 0);
+    return true;
+}
+
+void Hd44780::queueNibble(uint8_t nibble) {
+    uint8_t bits = (nibble << 4) | _backlight;
+    TwiMaster::queue(bits | PIN_E);
+    TwiMaster::queue(bits);
+}
+
+// Data is latched on E's falling edge; RS and data are set up with E rising
+bool Hd44780::queueByte(uint8_t value, uint8_t mode) {
+    if (room() == 0) {
+        return false;
+    }
+    uint8_t high = (value & 0xF0) | mode | _backlight;
+    uint8_t low = (value << 4) | mode | _backlight;
+    TwiMaster::queue(high | PIN_E);
+    TwiMaster::queue(high);
+    TwiMaster::queue(low | PIN_E);
+    TwiMaster::queue(low);
+    return true;
+}
+
+void Hd44780::sendNibbleBlocking(uint8_t nibble, uint8_t mode) {
+    uint8_t bits = (nibble << 4) | mode | _backlight;
+    uint8_t pulse[] = { (uint8_t)(bits | PIN_E), bits };
+    TwiMaster::write(_address, pulse, sizeof(pulse));
+}
+
+void Hd44780::commandBlocking(uint8_t command) {
+    sendNibbleBlocking(command >> 4, 0);
+    sendNibbleBlocking(command & 0x0F, 0);
+    delayMicroseconds(50);
+}
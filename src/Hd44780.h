@@ -0,0 +1,53 @@
+// src/Hd44780.h
+#pragma once
+#include <stdint.h>
+
+// HD44780 in 4-bit mode behind a PCF8574 backpack (P0 RS, P1 RW, P2 E,
+// P3 backlight, P4-P7 D4-D7). Each LCD byte becomes four expander bytes
+// (two nibbles, E high then low) queued on the TwiMaster stream; at 100 kHz
+// consecutive E pulses are 180 us apart, well over the 37 us command time,
+// so no busy-flag reads or delays are needed after begin().
+class Hd44780 {
+public:
+    static const bool HAS_CGRAM = true;
+
+    Hd44780(uint8_t address, uint8_t rows);
+    // Blocking init sequence (~60 ms); the only place clear() is used
+    void begin();
+    // Queue operations; false (and nothing queued) when the queue is full
+    bool setCursor(uint8_t col, uint8_t row);
+    bool write(uint8_t value);
+    // Uploads a 5x8 glyph for character code slot (0-7); leaves the address
+    // counter in CGRAM, so the next write needs a setCursor() first
+    bool createChar(uint8_t slot, const uint8_t* rows);
+    // setCursor()/write() operations that can be queued right now
+    uint8_t room() const;
+    // All queued bytes are on the glass
+    bool idle() const;
+    // Queues the 4-bit handshake and mode setup again after a failed
+    // transaction left the controller out of step; false when it won't fit
+    bool resync();
+private:
+    uint8_t _address;
+    uint8_t _rows;
+    uint8_t _backlight;
+
+    bool queueByte(uint8_t value, uint8_t mode);
+    void queueNibble(uint8_t nibble);
+    void sendNibbleBlocking(uint8_t nibble, uint8_t mode);
+    void commandBlocking(uint8_t command);
+};
+
+// Fixes the geometry at compile time for DisplayManager's frame buffers;
+// 16x2 and 20x4 modules share the controller code above
+template <uint8_t C, uint8_t R>
+class CharLcd : public Hd44780 {
+    static_assert(R <= 4, "HD44780 addresses at most four rows");
+public:
+    static constexpr uint8_t COLS = C;
+    static constexpr uint8_t ROWS = R;
+    explicit CharLcd(uint8_t address) : Hd44780(address, R) {}
+};
+
+template <uint8_t C, uint8_t R> constexpr uint8_t CharLcd<C, R>::COLS;
+template <uint8_t C, uint8_t R> constexpr uint8_t CharLcd<C, R>::ROWS;
@@ -0,0 +1,148 @@
+// src/HumiditySensor.cpp
+#include "HumiditySensor.h"
+
+#if ENABLE_HUMIDITY
+#include <Arduino.h>
+#include "TwiMaster.h"
+
+static const uint8_t CMD_SINGLE_SHOT_HIGH[] = { 0x24, 0x00 };  // No clock stretching
+static const uint8_t CMD_SOFT_RESET[] = { 0x30, 0xA2 };
+
+HumiditySensor::HumiditySensor(uint8_t address) : _address(address) {}
+
+bool HumiditySensor::begin() {
+    _present = TwiMaster::write(_address, CMD_SOFT_RESET, sizeof(CMD_SOFT_RESET)) == TwiMaster::TWI_OK;
+    _phase = PHASE_IDLE;
+    return _present;
+}
+
+bool HumiditySensor::present() const {
+    return _present;
+}
+
+void HumiditySensor::startMeasurement() {
+    if (_present && _phase == PHASE_IDLE) {
+        _phase = PHASE_START;
+    }
+}
+
+bool HumiditySensor::poll() {
+    switch (_phase) {
+        case PHASE_START:
+            if (TwiMaster::startWrite(_address, CMD_SINGLE_SHOT_HIGH, sizeof(CMD_SINGLE_SHOT_HIGH))) {
+                _phase = PHASE_COMMAND;
+            }
+            break;
+
+        case PHASE_COMMAND:
+            if (TwiMaster::status() == TwiMaster::TWI_BUSY) {
+                break;
+            }
+            if (TwiMaster::status() == TwiMaster::TWI_OK) {
+                _startMs = millis();
+                _phase = PHASE_MEASURING;
+            } else {
+                noteError();
+                _phase = PHASE_IDLE;
+            }
+            break;
+
+        case PHASE_MEASURING:
+            if (millis() - _startMs >= HUMIDITY_MEASURE_MS &&
+                TwiMaster::startRead(_address, 6)) {
+                _phase = PHASE_READING;
+            }
+            break;
+
+        case PHASE_READING: {
+            TwiMaster::Status status = TwiMaster::status();
+            if (status == TwiMaster::TWI_BUSY) {
+                break;
+            }
+            if (status == TwiMaster::TWI_OK) {
+                _phase = PHASE_IDLE;
+                if (parseResult(TwiMaster::readData())) {
+                    return true;
+                }
+                noteError();
+            } else if (status == TwiMaster::TWI_NACK_ADDRESS &&
+                       millis() - _startMs < 4 * HUMIDITY_MEASURE_MS) {
+                _phase = PHASE_MEASURING;  // Still converting; read again later
+            } else {
+                noteError();
+                _phase = PHASE_IDLE;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+    return false;
+}
+
+// Result: T msb, T lsb, CRC, RH msb, RH lsb, CRC
+bool HumiditySensor::parseResult(const uint8_t* data) {
+    if (crc8(data) != data[2] || crc8(data + 3) != data[5]) {
+        return false;
+    }
+    uint16_t rawT = (data[0] << 8) | data[1];
+    uint16_t rawRh = (data[3] << 8) | data[4];
+    // T = -45 + 175 * raw / 65535, RH = 100 * raw / 65535
+    _temperature = (centi_t)(((int32_t)17500 * rawT >> 16) - 4500);
+    _humidity = (centi_t)((uint32_t)10000 * rawRh >> 16);
+    _dewPoint = computeDewPoint(_temperature, _humidity);
+    _valid = true;
+    return true;
+}
+
+void HumiditySensor::noteError() {
+    _valid = false;
+    if (_errors < 255) {
+        _errors++;
+    }
+}
+
+// CRC-8, polynomial 0x31, init 0xFF, over one 2-byte word
+uint8_t HumiditySensor::crc8(const uint8_t* data) {
+    uint8_t crc = 0xFF;
+    for (uint8_t i = 0; i < 2; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// Magnus formula (b = 17.62, c = 243.12 C). Runs once per measurement, so
+// the single logf is not worth a table.
+centi_t HumiditySensor::computeDewPoint(centi_t temperature, centi_t humidity) {
+    if (humidity <= 0) {
+        humidity = 1;
+    }
+    float t = temperature / 100.0f;
+    float gamma = logf(humidity / 10000.0f) + 17.62f * t / (243.12f + t);
+    return (centi_t)(243.12f * gamma / (17.62f - gamma) * 100.0f);
+}
+
+bool HumiditySensor::valid() const {
+    return _valid;
+}
+
+centi_t HumiditySensor::humidity() const {
+    return _humidity;
+}
+
+centi_t HumiditySensor::temperature() const {
+    return _temperature;
+}
+
+centi_t HumiditySensor::dewPoint() const {
+    return _dewPoint;
+}
+
+uint8_t HumiditySensor::errors() const {
+    return _errors;
+}
+#endif  // ENABLE_HUMIDITY
@@ -0,0 +1,55 @@
+// src/HumiditySensor.h
+#pragma once
+#include <stdint.h>
+#include "Config.h"
+#include "FixedPoint.h"
+
+#if ENABLE_HUMIDITY
+// Sensirion SHT3x on the same I2C bus as the LCD. A single-shot measurement
+// is started without clock stretching, so the sensor NACKs its address until
+// the result is ready instead of holding SCL low; poll() only reads once the
+// conversion time has passed and retries on the next pass if it is early.
+// Both the command and the read are TwiMaster one-shot transactions, started
+// when the bus is free and collected on a later pass, so LCD stream and
+// sensor traffic interleave between transactions and never inside one.
+class HumiditySensor {
+public:
+    HumiditySensor(uint8_t address);
+    // Probes the address; the backend stays idle when nothing answers
+    bool begin();
+    bool present() const;
+    void startMeasurement();
+    // Returns true when a new measurement has been read
+    bool poll();
+
+    bool valid() const;
+    centi_t humidity() const;     // Hundredths of %RH
+    centi_t temperature() const;  // Hundredths of a degree C, at the sensor
+    centi_t dewPoint() const;
+    uint8_t errors() const;
+
+private:
+    enum Phase : uint8_t {
+        PHASE_IDLE,
+        PHASE_START,      // Command waiting for the bus
+        PHASE_COMMAND,    // Command on the wire
+        PHASE_MEASURING,
+        PHASE_READING     // Result read on the wire
+    };
+
+    uint8_t _address;
+    bool _present = false;
+    bool _valid = false;
+    Phase _phase = PHASE_IDLE;
+    unsigned long _startMs = 0;
+    centi_t _humidity = 0;
+    centi_t _temperature = 0;
+    centi_t _dewPoint = 0;
+    uint8_t _errors = 0;  // Saturating count of CRC and bus failures
+
+    bool parseResult(const uint8_t* data);
+    void noteError();
+    static uint8_t crc8(const uint8_t* data);
+    static centi_t computeDewPoint(centi_t temperature, centi_t humidity);
+};
+#endif  // ENABLE_HUMIDITY
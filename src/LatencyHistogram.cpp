@@ -0,0 +1,56 @@
+// src/LatencyHistogram.cpp
+#include "LatencyHistogram.h"
+
+void LatencyHistogram::record(uint32_t us) {
+    uint8_t bucket = 0;
+    for (uint32_t v = us >> 1; v && bucket < BUCKETS - 1; v >>= 1) {
+        bucket++;
+    }
+    if (_buckets[bucket] == 0xFFFF) {
+        for (uint8_t b = 0; b < BUCKETS; b++) {
+            _buckets[b] >>= 1;
+        }
+    }
+    _buckets[bucket]++;
+    if (us > _max) {
+        _max = us;
+    }
+}
+
+void LatencyHistogram::reset() {
+    memset(_buckets, 0, sizeof(_buckets));
+    _max = 0;
+}
+
+uint32_t LatencyHistogram::count() const {
+    uint32_t total = 0;
+    for (uint8_t b = 0; b < BUCKETS; b++) {
+        total += _buckets[b];
+    }
+    return total;
+}
+
+uint32_t LatencyHistogram::maximum() const {
+    return _max;
+}
+
+uint32_t LatencyHistogram::percentile(uint8_t pct) const {
+    uint32_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+    // Rank of the wanted sample, 1-based, rounded up
+    uint32_t rank = (total * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t b = 0; b < BUCKETS; b++) {
+        if (seen + _buckets[b] < rank) {
+            seen += _buckets[b];
+            continue;
+        }
+        uint32_t low = b == 0 ? 0 : 1UL << b;
+        uint32_t high = b == BUCKETS - 1 ? _max : (2UL << b) - 1;
+        uint32_t value = low + (uint64_t)(high - low) * (rank - seen) / _buckets[b];
+        return value < _max ? value : _max;
+    }
+    return _max;
+}
@@ -0,0 +1,25 @@
+// src/LatencyHistogram.h
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+// Log2 histogram of durations in microseconds: bucket b counts values in
+// [2^b, 2^(b+1)), bucket 0 also takes 0, and the last bucket is open-ended
+// (32.8 ms and up). Recording is a shift loop and an increment. When a
+// bucket would overflow, every bucket is halved, so the shape (and the
+// percentiles) survive days of loop() passes while older passes weigh less.
+// Percentiles interpolate linearly inside a bucket.
+class LatencyHistogram {
+public:
+    static const uint8_t BUCKETS = 16;
+
+    void record(uint32_t us);
+    void reset();
+    uint32_t count() const;
+    uint32_t maximum() const;
+    // pct 1-99; 0 when empty
+    uint32_t percentile(uint8_t pct) const;
+private:
+    uint16_t _buckets[BUCKETS] = {};
+    uint32_t _max = 0;
+};
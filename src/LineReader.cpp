@@ -0,0 +1,55 @@
+// src/LineReader.cpp
+#include "LineReader.h"
+
+LineReader::Result LineReader::poll(Stream& in, uint8_t budget) {
+    if (_ready) {
+        _ready = false;
+        _length = 0;
+    }
+    while (budget-- > 0 && in.available() > 0) {
+        char c = in.read();
+        if (c == '\r' || c == '\n') {
+            if (_overflow) {
+                _overflow = false;
+                _length = 0;
+                return LINE_TOO_LONG;
+            }
+            if (_length > 0 && _buffer[_length - 1] == ' ') {
+                _length--;
+            }
+            if (_length == 0) {
+                continue;  // Blank line, or the LF of a CRLF
+            }
+            _buffer[_length] = '\0';
+            _ready = true;
+            return LINE_READY;
+        }
+        if (_overflow) {
+            continue;  // Drop the rest of the line
+        }
+        if (c == '\b' || c == 0x7F) {
+            if (_length > 0) {
+                _length--;
+            }
+            continue;
+        }
+        if (c == ' ' || c == '\t') {
+            if (_length == 0 || _buffer[_length - 1] == ' ') {
+                continue;
+            }
+            c = ' ';
+        } else if (c < ' ') {
+            continue;
+        }
+        if (_length == SIZE) {
+            _overflow = true;
+            continue;
+        }
+        _buffer[_length++] = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+    }
+    return LINE_NONE;
+}
+
+char* LineReader::line() {
+    return _buffer;
+}
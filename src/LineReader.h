@@ -0,0 +1,27 @@
+// src/LineReader.h
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+
+// Collects a command line from a Stream without blocking: poll() takes at
+// most `budget` bytes per call and never waits for more. Lines end at CR or
+// LF; they are lowercased, trimmed and runs of spaces collapse to one as
+// they arrive, so handlers can split on single spaces. Backspace edits the
+// line. The buffer is static, so a line never touches the heap.
+class LineReader {
+public:
+    static const uint8_t SIZE = SERIAL_LINE_SIZE;
+    enum Result : uint8_t {
+        LINE_NONE,     // Nothing complete yet
+        LINE_READY,    // line() holds a non-empty line until the next poll()
+        LINE_TOO_LONG  // A line overflowed SIZE and was discarded
+    };
+
+    Result poll(Stream& in, uint8_t budget);
+    char* line();
+private:
+    char _buffer[SIZE + 1];
+    uint8_t _length = 0;
+    bool _overflow = false;
+    bool _ready = false;
+};
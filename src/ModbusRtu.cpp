@@ -0,0 +1,44 @@
+// src/ModbusRtu.cpp
+#include "ModbusRtu.h"
+#include "Crc16.h"
+
+static const uint8_t MIN_REQUEST = 8;  // Address, function, 4 bytes, CRC
+
+uint16_t ModbusRtu::crc(const uint8_t* data, uint8_t length) {
+    return crc16(data, length);
+}
+
+bool ModbusRtu::crcValid(const uint8_t* frame, uint8_t length) {
+    if (length < 4) {
+        return false;
+    }
+    uint16_t received = frame[length - 2] | (uint16_t)frame[length - 1] << 8;
+    return crc(frame, length - 2) == received;
+}
+
+uint16_t ModbusRtu::requestLength(const uint8_t* p, uint8_t available, uint8_t address) {
+    if (available < MIN_REQUEST || (p[0] != address && p[0] != BROADCAST)) {
+        return 0;
+    }
+    switch (p[1]) {
+        case FN_READ_HOLDING:
+        case FN_READ_INPUT:
+        case FN_WRITE_SINGLE:   return MIN_REQUEST;
+        case FN_WRITE_MULTIPLE: return available >= 9 ? 9 + p[6] : 0;  // 7 bytes + values + CRC
+        default:                return 0;
+    }
+}
+
+// The slave times frame ends from when it drains the RX ring, not from when
+// bytes arrived, so a long loop() pass can merge another slave's reply with
+// the next request; that request is then the tail of the buffer
+uint8_t ModbusRtu::findTrailingRequest(const uint8_t* frame, uint8_t length, uint8_t address) {
+    for (uint8_t start = 1; start + MIN_REQUEST <= length; start++) {
+        uint8_t available = length - start;
+        if (requestLength(frame + start, available, address) == available
+            && crcValid(frame + start, available)) {
+            return start;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,27 @@
+// src/ModbusRtu.h
+#pragma once
+#include <stdint.h>
+
+// Modbus RTU framing for ModbusSlave: CRC check, expected request lengths
+// and recovery of a request merged behind other bus traffic. Works on byte
+// buffers only (no Serial, no Arduino), so the native tests build it as is.
+class ModbusRtu {
+public:
+    static const uint8_t FN_READ_HOLDING = 0x03;
+    static const uint8_t FN_READ_INPUT = 0x04;
+    static const uint8_t FN_WRITE_SINGLE = 0x06;
+    static const uint8_t FN_WRITE_MULTIPLE = 0x10;
+    static const uint8_t BROADCAST = 0;
+
+    // CRC-16/MODBUS of length bytes
+    static uint16_t crc(const uint8_t* data, uint8_t length);
+    // The last two bytes of the frame are the CRC of the rest
+    static bool crcValid(const uint8_t* frame, uint8_t length);
+    // Length a request starting at p should have, from its function code; 0
+    // if it is not for address (or broadcast), not a function served here,
+    // or too little of it is available to tell
+    static uint16_t requestLength(const uint8_t* p, uint8_t available, uint8_t address);
+    // Offset of a request for address that ends the buffer exactly and
+    // checks out; 0 if there is none
+    static uint8_t findTrailingRequest(const uint8_t* frame, uint8_t length, uint8_t address);
+};
@@ -0,0 +1,276 @@
+// src/ModbusSlave.cpp
+#include "ModbusSlave.h"
+
+#if ENABLE_MODBUS
+#include "ModbusRtu.h"
+#include "Trace.h"
+
+static const uint8_t FN_READ_HOLDING = ModbusRtu::FN_READ_HOLDING;
+static const uint8_t FN_READ_INPUT = ModbusRtu::FN_READ_INPUT;
+static const uint8_t FN_WRITE_SINGLE = ModbusRtu::FN_WRITE_SINGLE;
+static const uint8_t FN_WRITE_MULTIPLE = ModbusRtu::FN_WRITE_MULTIPLE;
+static const uint8_t BROADCAST = ModbusRtu::BROADCAST;
+
+static uint16_t getWord(const uint8_t* p) {
+    return (uint16_t)p[0] << 8 | p[1];
+}
+
+static void putWord(uint8_t* p, uint16_t value) {
+    p[0] = value >> 8;
+    p[1] = value & 0xFF;
+}
+
+// 3.5 characters of 11 bits (start, 8 data, parity, stop); the spec fixes
+// 1750 us above 19200 baud, where polling could not resolve shorter gaps
+ModbusSlave::ModbusSlave(SystemState& state, SensorManager& sensorManager)
+    : _state(state), _sensorManager(sensorManager),
+      _silenceUs(MODBUS_BAUD > 19200 ? 1750 : 38500000UL / MODBUS_BAUD) {}
+
+void ModbusSlave::begin() {
+#if MODBUS_DE_PIN >= 0
+    digitalWrite(MODBUS_DE_PIN, LOW);
+    pinMode(MODBUS_DE_PIN, OUTPUT);
+#endif
+    if (MODBUS_AT_BOOT) {
+        setActive(true);
+    }
+}
+
+void ModbusSlave::setActive(bool active) {
+    Serial.flush();
+    Serial.begin(active ? MODBUS_BAUD : SERIAL_BAUD, active ? SERIAL_8E1 : SERIAL_8N1);
+    while (Serial.available() > 0) {
+        Serial.read();
+    }
+    _active = active;
+    _transmitting = false;
+    _leaving = false;
+    _overrun = false;
+    _length = 0;
+    trace.setMuted(active);
+}
+
+bool ModbusSlave::active() const {
+    return _active;
+}
+
+void ModbusSlave::poll() {
+    if (_transmitting) {
+        if (!transmitDone()) {
+            return;
+        }
+#if MODBUS_DE_PIN >= 0
+        digitalWrite(MODBUS_DE_PIN, LOW);
+#endif
+        _transmitting = false;
+    }
+    if (_leaving) {
+        setActive(false);
+        Serial.println(F("✓ Modbus mode DISABLED"));
+        return;
+    }
+    while (Serial.available() > 0) {
+        if (_length == FRAME_SIZE) {
+            // Keep the newest bytes: a request to us may follow a long
+            // reply from another slave without a gap we could see
+            memmove(_frame, _frame + 1, FRAME_SIZE - 1);
+            _length--;
+            _overrun = true;
+        }
+        _frame[_length++] = Serial.read();
+        _lastByteUs = micros();
+    }
+    if (_length == 0 || micros() - _lastByteUs < _silenceUs) {
+        return;
+    }
+    handleFrame();
+    _length = 0;  // The reply, if any, is already copied into the TX ring
+    _overrun = false;
+}
+
+// The whole reply is in the TX ring at once, so this is the shift register
+// emptying: ring drained and TXC set
+bool ModbusSlave::transmitDone() const {
+    return Serial.availableForWrite() >= SERIAL_TX_BUFFER_SIZE - 1 && (UCSR0A & _BV(TXC0));
+}
+
+void ModbusSlave::handleFrame() {
+    if (_length < 4) {
+        return;  // Line noise
+    }
+    if (_overrun || !ModbusRtu::crcValid(_frame, _length)) {
+        uint8_t start = ModbusRtu::findTrailingRequest(_frame, _length, MODBUS_ADDRESS);
+        if (start == 0) {
+            if (_overrun) {
+                _overruns++;
+            } else {
+                _crcErrors++;
+            }
+            return;
+        }
+        _length -= start;
+        memmove(_frame, _frame + start, _length);
+        _resyncs++;
+    }
+    uint8_t address = _frame[0];
+    if (address != MODBUS_ADDRESS && address != BROADCAST) {
+        return;
+    }
+    _frames++;
+
+    uint8_t function = _frame[1];
+    uint8_t pduLength = _length - 4;  // After address and function, before CRC
+    Exception ex = EX_ILLEGAL_FUNCTION;
+    uint8_t replyLength = 0;
+    if ((function == FN_READ_HOLDING || function == FN_READ_INPUT) && address != BROADCAST) {
+        ex = pduLength == 4 ? EX_NONE : EX_ILLEGAL_VALUE;
+        if (ex == EX_NONE) {
+            uint16_t count = getWord(_frame + 4);
+            ex = readRegisters(function == FN_READ_INPUT, getWord(_frame + 2), count);
+            replyLength = 3 + count * 2;
+        }
+    } else if (function == FN_WRITE_SINGLE) {
+        ex = pduLength == 4 ? writeRegisters(getWord(_frame + 2), 1, _frame + 4) : EX_ILLEGAL_VALUE;
+        replyLength = 6;  // Echo of address and value
+    } else if (function == FN_WRITE_MULTIPLE) {
+        uint16_t count = getWord(_frame + 4);
+        bool sized = pduLength >= 5 && _frame[6] == count * 2 && pduLength == 5 + _frame[6];
+        ex = sized ? writeRegisters(getWord(_frame + 2), count, _frame + 7) : EX_ILLEGAL_VALUE;
+        replyLength = 6;  // Start address and count
+    }
+
+    if (address == BROADCAST) {
+        return;
+    }
+    if (ex != EX_NONE) {
+        _exceptions++;
+        _frame[1] = function | 0x80;
+        _frame[2] = ex;
+        replyLength = 3;
+    }
+    reply(replyLength);
+}
+
+// Builds the reply in place: byte count, then the values
+ModbusSlave::Exception ModbusSlave::readRegisters(bool input, uint16_t start, uint16_t count) {
+    if (count == 0 || count > MAX_READ) {
+        return EX_ILLEGAL_VALUE;
+    }
+    uint8_t* out = _frame + 3;
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t value;
+        bool valid = input ? readInput(start + i, value) : readHolding(start + i, value);
+        if (!valid) {
+            return EX_ILLEGAL_ADDRESS;
+        }
+        putWord(out + i * 2, value);
+    }
+    _frame[2] = count * 2;
+    return EX_NONE;
+}
+
+// All values are checked before any is applied
+ModbusSlave::Exception ModbusSlave::writeRegisters(uint16_t start, uint16_t count,
+                                                   const uint8_t* values) {
+    if (count == 0 || count > HR_COUNT) {
+        return EX_ILLEGAL_VALUE;
+    }
+    if (start >= HR_COUNT || start + count > HR_COUNT) {
+        return EX_ILLEGAL_ADDRESS;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        if (!validHolding(start + i, getWord(values + i * 2))) {
+            return EX_ILLEGAL_VALUE;
+        }
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        writeHolding(start + i, getWord(values + i * 2));
+    }
+    return EX_NONE;
+}
+
+bool ModbusSlave::readInput(uint16_t address, uint16_t& value) const {
+    if (address >= IR_CHANNEL_TEMP && address < IR_CHANNEL_TEMP + SENSOR_CHANNEL_COUNT) {
+        value = _state.channelTemp[address - IR_CHANNEL_TEMP];
+        return true;
+    }
+    if (address >= IR_CHANNEL_FAULT && address < IR_CHANNEL_FAULT + SENSOR_CHANNEL_COUNT) {
+        value = _state.channelFault[address - IR_CHANNEL_FAULT];
+        return true;
+    }
+    switch (address) {
+        case IR_ROOM_TEMP:      value = _state.roomTemp; return true;
+        case IR_ALGAE_TEMP:     value = _state.algaeTemp; return true;
+        case IR_ROOM_FAULT:     value = _state.roomFault; return true;
+        case IR_ALGAE_FAULT:    value = _state.algaeFault; return true;
+        case IR_HUMIDITY:       value = _state.humidity; return true;
+        case IR_DEW_POINT:      value = _state.dewPoint; return true;
+        case IR_HUMIDITY_FAULT: value = _state.humidityValid ? FAULT_NONE : FAULT_COMM; return true;
+        case IR_INTERVAL:       value = _sensorManager.readingInterval(); return true;
+        case IR_UPTIME_HIGH:    value = (millis() / 1000) >> 16; return true;
+        case IR_UPTIME_LOW:     value = (millis() / 1000) & 0xFFFF; return true;
+        default:                return false;
+    }
+}
+
+bool ModbusSlave::readHolding(uint16_t address, uint16_t& value) const {
+    AdaptiveInterval& interval = _sensorManager.adaptiveInterval();
+    switch (address) {
+        case HR_FAKE_MODE:   value = _state.fakeMode; return true;
+        case HR_DEBUG_MODE:  value = _state.debugMode; return true;
+        case HR_LOW_POWER:   value = _state.lowPowerMode; return true;
+        case HR_ADAPTIVE:    value = interval.enabled(); return true;
+        case HR_INTERVAL:    value = interval.baseInterval(); return true;
+        case HR_MODBUS_MODE: value = _active; return true;
+        default:             return false;
+    }
+}
+
+bool ModbusSlave::validHolding(uint16_t address, uint16_t value) {
+    if (address == HR_INTERVAL) {
+        return value >= MIN_UPDATE_INTERVAL && value <= MAX_UPDATE_INTERVAL;
+    }
+    return value <= 1;
+}
+
+void ModbusSlave::writeHolding(uint16_t address, uint16_t value) {
+    AdaptiveInterval& interval = _sensorManager.adaptiveInterval();
+    switch (address) {
+        case HR_FAKE_MODE:   _state.fakeMode = value; break;
+        case HR_DEBUG_MODE:  _state.debugMode = value; break;
+        case HR_LOW_POWER:   _state.lowPowerMode = value; break;
+        case HR_ADAPTIVE:    interval.setEnabled(value); break;
+        case HR_INTERVAL:    interval.setBaseInterval(value); break;
+        case HR_MODBUS_MODE: _leaving = value == 0; break;
+    }
+}
+
+void ModbusSlave::reply(uint8_t length) {
+    uint16_t sum = ModbusRtu::crc(_frame, length);
+    _frame[length++] = sum & 0xFF;
+    _frame[length++] = sum >> 8;
+#if MODBUS_DE_PIN >= 0
+    digitalWrite(MODBUS_DE_PIN, HIGH);
+#endif
+    UCSR0A |= _BV(TXC0);  // Clear a stale TXC (write one) before queueing
+    Serial.write(_frame, length);
+    _transmitting = true;
+}
+
+void ModbusSlave::printStats(Print& out) const {
+    out.print(F("Modbus: address "));
+    out.print(MODBUS_ADDRESS);
+    out.print(F(", "));
+    out.print(_frames);
+    out.print(F(" frames, "));
+    out.print(_exceptions);
+    out.print(F(" exceptions, "));
+    out.print(_crcErrors);
+    out.print(F(" CRC errors, "));
+    out.print(_overruns);
+    out.print(F(" overruns, "));
+    out.print(_resyncs);
+    out.println(F(" resynced"));
+}
+
+#endif  // ENABLE_MODBUS
@@ -0,0 +1,90 @@
+// src/ModbusSlave.h
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+#include "State.h"
+#include "SensorManager.h"
+
+#if ENABLE_MODBUS
+
+// Modbus RTU slave on the serial port, for building-management masters on an
+// RS-485 bus. While active it owns Serial (MODBUS_BAUD, 8E1): the text
+// console, telemetry and debug trace are silent. Bytes are collected without
+// blocking; a frame ends after 3.5 character times of silence (fixed 1750 us
+// above 19200 baud, as the spec allows). That silence is seen only when
+// loop() drains the RX ring, so a frame that fails its CRC is searched for
+// a valid request to us at its tail. Functions 03/04 read and 06/16
+// write; addresses and values outside the map get exception 02/03.
+// MODBUS_DE_PIN drives the transceiver's DE/RE while a reply is on the wire.
+//
+// Input registers (04):
+//   0 room temp, 1 algae temp       signed hundredths of a degree C
+//   2 room fault, 3 algae fault     SensorFault code, 0 = OK
+//   4 humidity (hundredths %RH), 5 dew point, 6 humidity fault
+//   7 current reading interval ms
+//   8-9 uptime seconds (high word first)
+//   16+n channel n temp, 24+n channel n fault (SENSOR_CHANNELS order)
+// Holding registers (03, 06, 16):
+//   0 fake mode, 1 debug mode, 2 low-power mode, 3 adaptive interval (0/1)
+//   4 fixed/starting reading interval ms (MIN to MAX_UPDATE_INTERVAL)
+//   5 Modbus mode: write 0 to hand the port back to the text console
+class ModbusSlave {
+public:
+    ModbusSlave(SystemState& state, SensorManager& sensorManager);
+    void begin();
+    void setActive(bool active);
+    bool active() const;
+    // Call every loop() while active()
+    void poll();
+    void printStats(Print& out) const;
+private:
+    enum InputRegister : uint16_t {
+        IR_ROOM_TEMP, IR_ALGAE_TEMP, IR_ROOM_FAULT, IR_ALGAE_FAULT,
+        IR_HUMIDITY, IR_DEW_POINT, IR_HUMIDITY_FAULT, IR_INTERVAL,
+        IR_UPTIME_HIGH, IR_UPTIME_LOW,
+        IR_CHANNEL_TEMP = 16,
+        IR_CHANNEL_FAULT = 24
+    };
+    enum HoldingRegister : uint16_t {
+        HR_FAKE_MODE, HR_DEBUG_MODE, HR_LOW_POWER, HR_ADAPTIVE,
+        HR_INTERVAL, HR_MODBUS_MODE, HR_COUNT
+    };
+    enum Exception : uint8_t {
+        EX_NONE = 0,
+        EX_ILLEGAL_FUNCTION = 1,
+        EX_ILLEGAL_ADDRESS = 2,
+        EX_ILLEGAL_VALUE = 3
+    };
+    static const uint8_t FRAME_SIZE = 64;
+    // Registers per read that fit a FRAME_SIZE reply (address, function,
+    // byte count, data, CRC)
+    static const uint8_t MAX_READ = (FRAME_SIZE - 5) / 2;
+
+    SystemState& _state;
+    SensorManager& _sensorManager;
+    bool _active = false;
+    bool _transmitting = false;
+    bool _leaving = false;  // Return to the console once the reply is out
+    bool _overrun = false;
+    uint8_t _frame[FRAME_SIZE];
+    uint8_t _length = 0;
+    unsigned long _lastByteUs = 0;
+    uint16_t _silenceUs;
+
+    uint16_t _frames = 0;
+    uint16_t _crcErrors = 0;
+    uint16_t _exceptions = 0;
+    uint16_t _overruns = 0;
+    uint16_t _resyncs = 0;  // Requests recovered from the tail of a bad frame
+
+    void handleFrame();
+    Exception readRegisters(bool input, uint16_t start, uint16_t count);
+    Exception writeRegisters(uint16_t start, uint16_t count, const uint8_t* values);
+    bool readInput(uint16_t address, uint16_t& value) const;
+    bool readHolding(uint16_t address, uint16_t& value) const;
+    static bool validHolding(uint16_t address, uint16_t value);
+    void writeHolding(uint16_t address, uint16_t value);
+    void reply(uint8_t length);
+    bool transmitDone() const;
+};
+#endif  // ENABLE_MODBUS
@@ -0,0 +1,57 @@
+// src/Perf.cpp
+#include "Perf.h"
+#include "FixedPoint.h"
+
+#if ENABLE_PERF
+static LatencyHistogram histograms[PERF_SECTION_COUNT];
+static uint32_t lastMarkUs[PERF_SECTION_COUNT];
+static bool marked[PERF_SECTION_COUNT];
+
+static const char NAME_LOOP[] PROGMEM = "loop pass";
+static const char NAME_SERIAL_GAP[] PROGMEM = "serial gap";
+static const char NAME_SENSOR[] PROGMEM = "sensor update";
+static const char NAME_DISPLAY[] PROGMEM = "display update";
+static const char NAME_SERIAL[] PROGMEM = "serial process";
+static const char* const SECTION_NAMES[] PROGMEM = {
+    NAME_LOOP, NAME_SERIAL_GAP, NAME_SENSOR, NAME_DISPLAY, NAME_SERIAL
+};
+static_assert(sizeof(SECTION_NAMES) / sizeof(SECTION_NAMES[0]) == PERF_SECTION_COUNT,
+              "One name per section");
+
+void Perf::record(PerfSection section, uint32_t us) {
+    histograms[section].record(us);
+}
+
+// The first mark after boot or reset only sets the reference point
+void Perf::mark(PerfSection section) {
+    uint32_t now = micros();
+    if (marked[section]) {
+        histograms[section].record(now - lastMarkUs[section]);
+    }
+    lastMarkUs[section] = now;
+    marked[section] = true;
+}
+
+void Perf::printReport(Print& out) {
+    out.println(F("\n=== PERF (us) ==="));
+    out.println(F("Section           Count    p50    p99      max"));
+    for (uint8_t s = 0; s < PERF_SECTION_COUNT; s++) {
+        const LatencyHistogram& h = histograms[s];
+        PGM_P name = (PGM_P)pgm_read_ptr(&SECTION_NAMES[s]);
+        out.print((const __FlashStringHelper*)name);
+        printPadded(out, h.count(), 20 - strlen_P(name));
+        printPadded(out, h.percentile(50), 7);
+        printPadded(out, h.percentile(99), 7);
+        printPadded(out, h.maximum(), 9);
+        out.println();
+    }
+    out.println(F("=================\n"));
+}
+
+void Perf::reset() {
+    for (uint8_t s = 0; s < PERF_SECTION_COUNT; s++) {
+        histograms[s].reset();
+        marked[s] = false;
+    }
+}
+#endif  // ENABLE_PERF
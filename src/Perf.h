@@ -0,0 +1,55 @@
+// src/Perf.h
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+#include "LatencyHistogram.h"
+
+// On-device latency instrumentation. A PerfScope at the top of a function
+// records its duration into the section's histogram; Perf::mark() records
+// the time since the section's previous mark, for gaps such as how long the
+// UART goes unserviced. With ENABLE_PERF 0 both compile to nothing and the
+// histograms take no RAM.
+enum PerfSection : uint8_t {
+    PERF_LOOP,            // One scheduler pass: all due tasks
+    PERF_SERIAL_GAP,      // Between SerialCommander::process() calls
+    PERF_SENSOR_UPDATE,   // SensorManager::update()
+    PERF_DISPLAY_UPDATE,  // DisplayManager::update() (page render)
+    PERF_SERIAL_PROCESS,  // SerialCommander::process()
+    PERF_SECTION_COUNT
+};
+
+#if ENABLE_PERF
+class Perf {
+public:
+    static void record(PerfSection section, uint32_t us);
+    static void mark(PerfSection section);
+    static void printReport(Print& out);
+    static void reset();
+};
+
+class PerfScope {
+public:
+    explicit PerfScope(PerfSection section) : _section(section), _start(micros()) {}
+    ~PerfScope() {
+        Perf::record(_section, micros() - _start);
+    }
+private:
+    PerfSection _section;
+    uint32_t _start;
+};
+#else
+class Perf {
+public:
+    static void record(PerfSection, uint32_t) {}
+    static void mark(PerfSection) {}
+    static void printReport(Print& out) {
+        out.println(F("Perf instrumentation disabled (ENABLE_PERF 0)"));
+    }
+    static void reset() {}
+};
+
+class PerfScope {
+public:
+    explicit PerfScope(PerfSection) {}
+};
+#endif
@@ -0,0 +1,84 @@
+// src/PowerManager.cpp
+#include "PowerManager.h"
+#include "AdcSampler.h"
+#include "Config.h"
+#include <Arduino.h>
+#include <avr/sleep.h>
+
+PowerManager::PowerManager(SystemState& state) : _state(state) {}
+
+void PowerManager::idle() {
+    if (!_state.lowPowerMode) {
+        return;
+    }
+    unsigned long start = micros();
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sleep_cpu();
+    sleep_disable();
+
+    _sleepUs += micros() - start;
+    while (_sleepUs >= 1000) {
+        _sleepUs -= 1000;
+        _sleepMs++;
+    }
+}
+
+void PowerManager::noteReading() {
+    if (_readings < 0xFFFF) {
+        _readings++;
+    }
+}
+
+void PowerManager::resetStats() {
+    _statsStartMs = millis();
+    _sleepMs = 0;
+    _sleepUs = 0;
+    _readings = 0;
+    _quietStart = AdcSampler::quietConversions();
+}
+
+void PowerManager::printReport() {
+    unsigned long elapsedMs = millis() - _statsStartMs;
+    // Noise-reduction sleep time is in elapsedMs (convertQuiet() credits
+    // Timer0 for it) but not in _sleepMs; estimate it from the conversions
+    uint32_t quiet = AdcSampler::quietConversions() - _quietStart;
+    float quietMs = quiet * (AdcSampler::QUIET_CONVERSION_US / 1000.0);
+    float sleepMs = _sleepMs + _sleepUs / 1000.0;
+    float totalMs = elapsedMs;
+    float awakeMs = totalMs - sleepMs;
+
+    Serial.println(F("\n=== POWER ==="));
+    Serial.print(F("Low-power mode: "));
+    Serial.println(_state.lowPowerMode ? F("ON") : F("OFF"));
+    Serial.print(F("Window: "));
+    Serial.print(totalMs / 1000.0, 1);
+    Serial.println(F(" s"));
+    if (totalMs <= 0) {
+        Serial.println(F("=============\n"));
+        return;
+    }
+    Serial.print(F("Awake: "));
+    Serial.print(100.0 * awakeMs / totalMs, 1);
+    Serial.print(F("% | Idle: "));
+    Serial.print(100.0 * sleepMs / totalMs, 1);
+    Serial.print(F("% | ADC sleep: "));
+    Serial.print(100.0 * quietMs / totalMs, 2);
+    Serial.println(F("%"));
+
+    // uA * ms = nC; times supply voltage in V gives nJ
+    float chargeNc = awakeMs * POWER_ACTIVE_UA + sleepMs * POWER_IDLE_UA
+                   + quietMs * POWER_ADC_SLEEP_UA;
+    float volts = POWER_SUPPLY_MV / 1000.0;
+    Serial.print(F("Avg current: "));
+    Serial.print(chargeNc / totalMs / 1000.0, 2);
+    Serial.println(F(" mA (MCU only, estimated)"));
+    Serial.print(F("Readings: "));
+    Serial.println(_readings);
+    if (_readings > 0) {
+        Serial.print(F("Energy/reading: "));
+        Serial.print(chargeNc * volts / _readings / 1000.0, 1);
+        Serial.println(F(" uJ"));
+    }
+    Serial.println(F("=============\n"));
+}
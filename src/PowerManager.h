@@ -0,0 +1,25 @@
+// src/PowerManager.h
+#pragma once
+#include <stdint.h>
+#include "State.h"
+
+// Low-power mode for solar nodes: the CPU idles between loop() passes (woken
+// by Timer0's 1 ms tick, UART RX or the ADC) and polled conversions run in
+// ADC noise-reduction sleep. Tracks awake/asleep time to estimate duty cycle
+// and energy per published reading.
+class PowerManager {
+public:
+    PowerManager(SystemState& state);
+    // Call at the end of loop(); returns at the next interrupt
+    void idle();
+    void noteReading();
+    void resetStats();
+    void printReport();
+private:
+    SystemState& _state;
+    unsigned long _statsStartMs = 0;
+    uint32_t _sleepMs = 0;
+    uint16_t _sleepUs = 0;  // Remainder below 1 ms
+    uint16_t _readings = 0;
+    uint32_t _quietStart = 0;
+};
@@ -0,0 +1,85 @@
+// src/ReadingStats.cpp
+#include "ReadingStats.h"
+#include <Arduino.h>
+
+void ReadingStats::update(const SystemState& state, unsigned long nowMs) {
+    if (_readings < 0xFFFF) {
+        _readings++;
+    }
+    updateRole(_room, state.roomTemp, state.roomFault, nowMs);
+    updateRole(_algae, state.algaeTemp, state.algaeFault, nowMs);
+    _history.push(state.roomTemp, state.roomFault == FAULT_NONE,
+                  state.algaeTemp, state.algaeFault == FAULT_NONE);
+
+    if (state.roomFault == FAULT_NONE && state.algaeFault == FAULT_NONE) {
+        centi_t delta = state.roomTemp - state.algaeTemp;
+        if (!_deltaSeen) {
+            _deltaSeen = true;
+            _deltaMin = _deltaMax = delta;
+        }
+        _deltaMin = min(_deltaMin, delta);
+        _deltaMax = max(_deltaMax, delta);
+    }
+}
+
+void ReadingStats::updateRole(RoleStats& role, centi_t value, SensorFault fault, unsigned long nowMs) {
+    if (fault != FAULT_NONE) {
+        if (role.faults < 0xFFFF) {
+            role.faults++;
+        }
+        return;
+    }
+    if (!role.seen) {
+        role.seen = true;
+        role.min = role.max = value;
+    } else {
+        role.min = min(role.min, value);
+        role.max = max(role.max, value);
+        unsigned long elapsedMs = nowMs - role.lastMs;
+        if (elapsedMs > 0) {
+            int32_t rate = ((int32_t)value - role.last) * 60000L / (int32_t)elapsedMs;
+            rate = constrain(rate, -32767L, 32767L);
+            // EMA 1/4 keeps single-LSB steps from swinging the trend
+            role.rate = (int16_t)(((int32_t)role.rate * 3 + rate) / 4);
+        }
+    }
+    role.last = value;
+    role.lastMs = nowMs;
+}
+
+void ReadingStats::reset() {
+    _room = RoleStats();
+    _algae = RoleStats();
+    _deltaSeen = false;
+    _deltaMin = _deltaMax = 0;
+    _readings = 0;
+    _history.clear();
+}
+
+const ReadingStats::RoleStats& ReadingStats::room() const {
+    return _room;
+}
+
+const ReadingStats::RoleStats& ReadingStats::algae() const {
+    return _algae;
+}
+
+bool ReadingStats::hasDelta() const {
+    return _deltaSeen;
+}
+
+centi_t ReadingStats::deltaMin() const {
+    return _deltaMin;
+}
+
+centi_t ReadingStats::deltaMax() const {
+    return _deltaMax;
+}
+
+uint16_t ReadingStats::readings() const {
+    return _readings;
+}
+
+const TrendHistory& ReadingStats::history() const {
+    return _history;
+}
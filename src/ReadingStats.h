@@ -0,0 +1,42 @@
+// src/ReadingStats.h
+#pragma once
+#include <stdint.h>
+#include "State.h"
+#include "TrendHistory.h"
+
+// Session aggregates updated once per published reading in O(1), so the LCD
+// pages and reports never walk a history. Faulted readings are counted but
+// left out of the ranges and rates. Also feeds the sparkline history.
+class ReadingStats {
+public:
+    struct RoleStats {
+        bool seen = false;
+        centi_t min = 0;
+        centi_t max = 0;
+        int16_t rate = 0;     // Smoothed dT/dt, centi-degrees per minute
+        uint16_t faults = 0;  // Readings published with a fault
+        centi_t last = 0;
+        unsigned long lastMs = 0;
+    };
+
+    void update(const SystemState& state, unsigned long nowMs);
+    void reset();
+    const RoleStats& room() const;
+    const RoleStats& algae() const;
+    // Room minus algae: the cooling effect
+    bool hasDelta() const;
+    centi_t deltaMin() const;
+    centi_t deltaMax() const;
+    uint16_t readings() const;
+    const TrendHistory& history() const;
+private:
+    RoleStats _room;
+    RoleStats _algae;
+    bool _deltaSeen = false;
+    centi_t _deltaMin = 0;
+    centi_t _deltaMax = 0;
+    uint16_t _readings = 0;
+    TrendHistory _history;
+
+    static void updateRole(RoleStats& role, centi_t value, SensorFault fault, unsigned long nowMs);
+};
@@ -0,0 +1,209 @@
+// src/ReadingStreamer.cpp
+#include "ReadingStreamer.h"
+#include <avr/pgmspace.h>
+#include "FixedPoint.h"
+
+// Field names are the `stream` arguments and CSV columns; faults is two CSV
+// columns or a [room, algae] JSON array of SensorFault codes
+static const char NAME_ROOM[] PROGMEM = "room";
+static const char NAME_ALGAE[] PROGMEM = "algae";
+static const char NAME_DELTA[] PROGMEM = "delta";
+static const char NAME_RH[] PROGMEM = "rh";
+static const char NAME_DEW[] PROGMEM = "dew";
+static const char NAME_FAULTS[] PROGMEM = "faults";
+static const char NAME_INTERVAL[] PROGMEM = "interval";
+static const char* const FIELD_NAMES[] PROGMEM = {
+    NAME_ROOM, NAME_ALGAE, NAME_DELTA, NAME_RH, NAME_DEW, NAME_FAULTS, NAME_INTERVAL
+};
+static_assert(sizeof(FIELD_NAMES) / sizeof(FIELD_NAMES[0]) == ReadingStreamer::FIELD_COUNT,
+              "One name per field");
+
+// JSON keys are kept short so the widest line fits the TX ring
+static const char KEY_ROOM[] PROGMEM = "r";
+static const char KEY_ALGAE[] PROGMEM = "a";
+static const char KEY_DELTA[] PROGMEM = "d";
+static const char KEY_RH[] PROGMEM = "rh";
+static const char KEY_DEW[] PROGMEM = "dp";
+static const char KEY_FAULTS[] PROGMEM = "f";
+static const char KEY_INTERVAL[] PROGMEM = "i";
+static const char* const JSON_KEYS[] PROGMEM = {
+    KEY_ROOM, KEY_ALGAE, KEY_DELTA, KEY_RH, KEY_DEW, KEY_FAULTS, KEY_INTERVAL
+};
+static_assert(sizeof(JSON_KEYS) / sizeof(JSON_KEYS[0]) == ReadingStreamer::FIELD_COUNT,
+              "One key per field");
+
+// Appends to a line; callers keep within LINE_SIZE by construction (seq,
+// timestamp and every field at their widest make 113 characters of JSON)
+class LineBuilder {
+public:
+    explicit LineBuilder(char* buf) : _p(buf) {}
+    void text_P(PGM_P s) {
+        strcpy_P(_p, s);
+        _p += strlen(_p);
+    }
+    void character(char c) {
+        *_p++ = c;
+    }
+    void number(uint32_t value) {
+        ultoa(value, _p, 10);
+        _p += strlen(_p);
+    }
+    void centi(centi_t value) {
+        _p += formatCenti(_p, value, 2);
+    }
+    char* end() const {
+        return _p;
+    }
+private:
+    char* _p;
+};
+
+void ReadingStreamer::start(Format format, uint8_t every, uint8_t fields) {
+    _format = format;
+    _every = max(every, (uint8_t)1);
+    _countdown = 0;
+    _fields = fields;
+    if (format != STREAM_CSV) {
+        return;
+    }
+    Serial.print(F("seq,ms"));
+    for (uint8_t f = 0; f < FIELD_COUNT; f++) {
+        if (!(_fields & (1 << f))) {
+            continue;
+        }
+        if (f == FIELD_FAULTS) {
+            Serial.print(F(",room_fault,algae_fault"));
+        } else {
+            Serial.print(',');
+            Serial.print((const __FlashStringHelper*)pgm_read_ptr(&FIELD_NAMES[f]));
+        }
+    }
+    Serial.println();
+}
+
+void ReadingStreamer::stop() {
+    _format = STREAM_OFF;
+}
+
+ReadingStreamer::Format ReadingStreamer::format() const {
+    return _format;
+}
+
+void ReadingStreamer::send(const SystemState& state, unsigned long nowMs, unsigned long intervalMs) {
+    if (_format == STREAM_OFF) {
+        return;
+    }
+    if (_countdown > 0) {
+        _countdown--;
+        return;
+    }
+    _countdown = _every - 1;
+
+    bool json = _format == STREAM_JSON;
+    bool roomOk = state.roomFault == FAULT_NONE;
+    bool algaeOk = state.algaeFault == FAULT_NONE;
+    char line[LINE_SIZE];
+    LineBuilder out(line);
+    out.text_P(json ? PSTR("{\"seq\":") : PSTR(""));
+    out.number(_seq++);
+    out.text_P(json ? PSTR(",\"ms\":") : PSTR(","));
+    out.number(nowMs);
+
+    for (uint8_t f = 0; f < FIELD_COUNT; f++) {
+        if (!(_fields & (1 << f))) {
+            continue;
+        }
+        out.character(',');
+        if (json) {
+            out.character('"');
+            out.text_P((PGM_P)pgm_read_ptr(&JSON_KEYS[f]));
+            out.text_P(PSTR("\":"));
+        }
+        bool valid = true;
+        switch (f) {
+            case FIELD_ROOM:
+                valid = roomOk;
+                if (valid) out.centi(state.roomTemp);
+                break;
+            case FIELD_ALGAE:
+                valid = algaeOk;
+                if (valid) out.centi(state.algaeTemp);
+                break;
+            case FIELD_DELTA:
+                valid = roomOk && algaeOk;
+                if (valid) out.centi(state.roomTemp - state.algaeTemp);
+                break;
+            case FIELD_RH:
+                valid = state.humidityValid;
+                if (valid) out.centi(state.humidity);
+                break;
+            case FIELD_DEW:
+                valid = state.humidityValid;
+                if (valid) out.centi(state.dewPoint);
+                break;
+            case FIELD_FAULTS:
+                out.text_P(json ? PSTR("[") : PSTR(""));
+                out.number(state.roomFault);
+                out.character(',');
+                out.number(state.algaeFault);
+                out.text_P(json ? PSTR("]") : PSTR(""));
+                break;
+            case FIELD_INTERVAL:
+                out.number(intervalMs);
+                break;
+        }
+        if (!valid && json) {
+            out.text_P(PSTR("null"));
+        }
+    }
+    if (json) {
+        out.character('}');
+    }
+    out.character('\r');
+    out.character('\n');
+
+    uint8_t length = out.end() - line;
+    if (Serial.availableForWrite() < length) {
+        _dropped++;
+        return;
+    }
+    Serial.write((const uint8_t*)line, length);
+    _sent++;
+}
+
+void ReadingStreamer::printStats(Print& out) const {
+    out.print(F("Stream: "));
+    switch (_format) {
+        case STREAM_CSV:  out.print(F("CSV")); break;
+        case STREAM_JSON: out.print(F("JSON")); break;
+        default:          out.print(F("OFF")); break;
+    }
+    out.print(F(", every "));
+    out.print(_every);
+    out.print(F(", "));
+    out.print(_sent);
+    out.print(F(" lines sent, "));
+    out.print(_dropped);
+    out.println(F(" dropped"));
+}
+
+uint8_t ReadingStreamer::parseFields(const char* list) {
+    uint8_t fields = 0;
+    while (*list) {
+        const char* comma = strchr(list, ',');
+        uint8_t length = comma ? comma - list : strlen(list);
+        uint8_t f = 0;
+        for (; f < FIELD_COUNT; f++) {
+            PGM_P name = (PGM_P)pgm_read_ptr(&FIELD_NAMES[f]);
+            if (length == strlen_P(name) && strncmp_P(list, name, length) == 0) {
+                break;
+            }
+        }
+        if (f == FIELD_COUNT) {
+            return 0;
+        }
+        fields |= 1 << f;
+        list += comma ? length + 1 : length;
+    }
+    return fields;
+}
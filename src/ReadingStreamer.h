@@ -0,0 +1,46 @@
+// src/ReadingStreamer.h
+#pragma once
+#include <Arduino.h>
+#include "State.h"
+
+// Continuous logging for hosts that want text: one CSV or JSON line per
+// published reading (or every Nth), always led by a sequence number and a
+// millis() timestamp, then the selected fields. Lines are built in a stack
+// buffer with formatCenti()/ultoa() and written whole if the TX buffer has
+// room; otherwise dropped and counted (the seq gap shows it), so logging
+// never holds up sampling. Faulted temperatures are empty (CSV) or null.
+// A line must fit the TX ring whole, and the ring never reports more than
+// SERIAL_TX_BUFFER_SIZE - 1 bytes free, so JSON uses one- and two-letter
+// keys: the widest all-fields line is 113 characters.
+class ReadingStreamer {
+public:
+    enum Format : uint8_t { STREAM_OFF, STREAM_CSV, STREAM_JSON };
+    enum Field : uint8_t {
+        FIELD_ROOM, FIELD_ALGAE, FIELD_DELTA, FIELD_RH, FIELD_DEW,
+        FIELD_FAULTS, FIELD_INTERVAL, FIELD_COUNT
+    };
+    static const uint8_t ALL_FIELDS = (1 << FIELD_COUNT) - 1;
+
+    // every = 1 streams each reading; CSV starts with a header line
+    void start(Format format, uint8_t every, uint8_t fields);
+    void stop();
+    Format format() const;
+    // Call with each published reading
+    void send(const SystemState& state, unsigned long nowMs, unsigned long intervalMs);
+    void printStats(Print& out) const;
+
+    // "room,algae,..." to a field mask; 0 if any name is unknown
+    static uint8_t parseFields(const char* list);
+private:
+    static const uint8_t LINE_SIZE = 120;
+    static_assert(LINE_SIZE < SERIAL_TX_BUFFER_SIZE,
+                  "Stream lines must fit the serial TX ring (see platformio.ini)");
+
+    Format _format = STREAM_OFF;
+    uint8_t _every = 1;
+    uint8_t _countdown = 0;
+    uint8_t _fields = ALL_FIELDS;
+    uint16_t _seq = 0;
+    uint16_t _sent = 0;
+    uint16_t _dropped = 0;
+};
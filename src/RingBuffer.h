@@ -0,0 +1,46 @@
+// src/RingBuffer.h
+#pragma once
+#include <stdint.h>
+
+// Lock-free single-producer/single-consumer queue. One side may run in an
+// ISR: each index is a single byte (atomic on AVR) owned by exactly one side.
+// N must be a power of two; one slot is kept free to tell full from empty.
+template <typename T, uint8_t N>
+class RingBuffer {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "RingBuffer size must be a power of two");
+public:
+    bool push(T item) {
+        uint8_t head = _head;
+        uint8_t next = (head + 1) & (N - 1);
+        if (next == _tail) {
+            return false;
+        }
+        _items[head] = item;
+        _head = next;
+        return true;
+    }
+
+    bool pop(T& item) {
+        uint8_t tail = _tail;
+        if (tail == _head) {
+            return false;
+        }
+        item = _items[tail];
+        _tail = (tail + 1) & (N - 1);
+        return true;
+    }
+
+    uint8_t size() const {
+        return (_head - _tail) & (N - 1);
+    }
+
+    // Consumer side only: drops everything queued so far
+    void clear() {
+        _tail = _head;
+    }
+
+private:
+    volatile T _items[N];
+    volatile uint8_t _head = 0;
+    volatile uint8_t _tail = 0;
+};
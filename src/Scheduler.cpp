@@ -0,0 +1,139 @@
+// src/Scheduler.cpp
+#include "Scheduler.h"
+#include "FixedPoint.h"
+
+uint8_t Scheduler::addPeriodic(const __FlashStringHelper* name, TaskFn fn, uint16_t periodMs,
+                               uint8_t priority, uint16_t deadlineMs) {
+    return add(name, fn, TASK_PERIODIC, priority, periodMs,
+               (uint32_t)(deadlineMs ? deadlineMs : periodMs) * 1000);
+}
+
+uint8_t Scheduler::addPolled(const __FlashStringHelper* name, TaskFn fn, uint8_t priority,
+                             uint16_t budgetUs) {
+    return add(name, fn, TASK_POLLED, priority, 0, budgetUs);
+}
+
+uint8_t Scheduler::addEvent(const __FlashStringHelper* name, TaskFn fn, uint8_t priority,
+                            uint16_t deadlineMs) {
+    return add(name, fn, TASK_EVENT, priority, 0, (uint32_t)deadlineMs * 1000);
+}
+
+uint8_t Scheduler::add(const __FlashStringHelper* name, TaskFn fn, Kind kind, uint8_t priority,
+                       uint16_t periodMs, uint32_t deadlineUs) {
+    if (_count == SCHEDULER_MAX_TASKS) {
+        return NO_TASK;
+    }
+    uint8_t id = _count++;
+    Task& task = _tasks[id];
+    task.name = name;
+    task.fn = fn;
+    task.kind = kind;
+    task.priority = priority;
+    task.pending = false;
+    task.periodMs = periodMs;
+    task.deadlineUs = deadlineUs;
+    task.dueUs = micros();  // Periodic tasks first run on the next pass
+    task.wcetUs = 0;
+    task.maxLateUs = 0;
+    task.runs = 0;
+    task.misses = 0;
+
+    // Insertion sort; equal priorities keep registration order
+    uint8_t slot = id;
+    while (slot > 0 && _tasks[_order[slot - 1]].priority > priority) {
+        _order[slot] = _order[slot - 1];
+        slot--;
+    }
+    _order[slot] = id;
+    return id;
+}
+
+void Scheduler::setPeriod(uint8_t task, uint16_t periodMs) {
+    if (task < _count) {
+        _tasks[task].periodMs = periodMs;
+        _tasks[task].deadlineUs = (uint32_t)periodMs * 1000;
+    }
+}
+
+void Scheduler::wake(uint8_t task) {
+    if (task < _count && !_tasks[task].pending) {
+        _tasks[task].pending = true;
+        _tasks[task].dueUs = micros();
+    }
+}
+
+void Scheduler::run() {
+    for (uint8_t i = 0; i < _count; i++) {
+        Task& task = _tasks[_order[i]];
+        uint32_t now = micros();
+        bool due = task.kind == TASK_POLLED ||
+                   (task.kind == TASK_EVENT && task.pending) ||
+                   (task.kind == TASK_PERIODIC && (int32_t)(now - task.dueUs) >= 0);
+        if (due) {
+            runTask(task, now);
+        }
+    }
+}
+
+void Scheduler::runTask(Task& task, uint32_t start) {
+    task.pending = false;
+    task.fn();
+    uint32_t end = micros();
+    uint32_t elapsed = end - start;
+    task.runs++;
+    task.wcetUs = max(task.wcetUs, elapsed);
+
+    if (task.kind == TASK_POLLED) {
+        if (elapsed > task.deadlineUs) {
+            task.misses++;
+        }
+        return;
+    }
+    task.maxLateUs = max(task.maxLateUs, start - task.dueUs);
+    if (end - task.dueUs > task.deadlineUs) {
+        task.misses++;
+    }
+    if (task.kind == TASK_PERIODIC) {
+        uint32_t periodUs = (uint32_t)task.periodMs * 1000;
+        task.dueUs += periodUs;
+        // A whole period behind: drop the lost slots instead of bursting
+        while ((int32_t)(end - task.dueUs) >= (int32_t)periodUs) {
+            task.dueUs += periodUs;
+            task.misses++;
+        }
+    }
+}
+
+void Scheduler::printStats(Print& out) const {
+    out.println(F("\n=== TASKS ==="));
+    out.println(F("Task      Pri  Period  Runs  WCET us  Late us  Miss"));
+    for (uint8_t i = 0; i < _count; i++) {
+        const Task& task = _tasks[_order[i]];
+        out.print(task.name);
+        printPadded(out, task.priority, 13 - strlen_P((PGM_P)task.name));
+        switch (task.kind) {
+            case TASK_PERIODIC: printPadded(out, task.periodMs, 8); break;
+            case TASK_POLLED:   out.print(F("    poll")); break;
+            default:            out.print(F("   event")); break;
+        }
+        printPadded(out, task.runs, 6);
+        printPadded(out, task.wcetUs, 9);
+        if (task.kind == TASK_POLLED) {
+            out.print(F("        -"));
+        } else {
+            printPadded(out, task.maxLateUs, 9);
+        }
+        printPadded(out, task.misses, 6);
+        out.println();
+    }
+    out.println(F("=============\n"));
+}
+
+void Scheduler::resetStats() {
+    for (uint8_t i = 0; i < _count; i++) {
+        _tasks[i].wcetUs = 0;
+        _tasks[i].maxLateUs = 0;
+        _tasks[i].runs = 0;
+        _tasks[i].misses = 0;
+    }
+}
@@ -0,0 +1,60 @@
+// src/Scheduler.h
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+
+// Cooperative run-to-completion scheduler for loop(). Three kinds of task:
+//  - periodic: due every periodMs, counted from the previous due time rather
+//    than from when it ran, so late runs do not push the schedule back;
+//  - polled: runs on every pass (state machines that do one step per call);
+//  - event: runs once after wake(), e.g. when a reading is published.
+// Each pass runs every due task in priority order (0 first). Per task it
+// keeps runs, worst-case execution time, worst start lateness and deadline
+// misses: a periodic or event task misses when it finishes later than
+// deadline after becoming due (a periodic task that falls a whole period
+// behind also skips the lost slots), a polled task when one run takes longer
+// than its budget and so holds up everything else.
+class Scheduler {
+public:
+    typedef void (*TaskFn)();
+    static const uint8_t NO_TASK = 0xFF;
+
+    // deadlineMs 0 means one period. Return NO_TASK when the table is full.
+    uint8_t addPeriodic(const __FlashStringHelper* name, TaskFn fn, uint16_t periodMs,
+                        uint8_t priority, uint16_t deadlineMs = 0);
+    uint8_t addPolled(const __FlashStringHelper* name, TaskFn fn, uint8_t priority,
+                      uint16_t budgetUs);
+    uint8_t addEvent(const __FlashStringHelper* name, TaskFn fn, uint8_t priority,
+                     uint16_t deadlineMs);
+    // Takes effect from the next due time; the deadline becomes one period
+    void setPeriod(uint8_t task, uint16_t periodMs);
+    void wake(uint8_t task);
+    // Call from loop()
+    void run();
+    void printStats(Print& out) const;
+    void resetStats();
+private:
+    enum Kind : uint8_t { TASK_PERIODIC, TASK_POLLED, TASK_EVENT };
+    struct Task {
+        const __FlashStringHelper* name;
+        TaskFn fn;
+        Kind kind;
+        uint8_t priority;
+        bool pending;
+        uint16_t periodMs;
+        uint32_t deadlineUs;  // Budget for polled tasks
+        uint32_t dueUs;
+        uint32_t wcetUs;
+        uint32_t maxLateUs;
+        uint16_t runs;
+        uint16_t misses;
+    };
+
+    Task _tasks[SCHEDULER_MAX_TASKS];
+    uint8_t _order[SCHEDULER_MAX_TASKS];  // Task indices by priority
+    uint8_t _count = 0;
+
+    uint8_t add(const __FlashStringHelper* name, TaskFn fn, Kind kind, uint8_t priority,
+                uint16_t periodMs, uint32_t deadlineUs);
+    void runTask(Task& task, uint32_t now);
+};
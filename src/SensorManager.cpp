@@ -1,60 +1,534 @@
 // src/SensorManager.cpp
 #include "SensorManager.h"
 #include "Config.h"
+#include "AdcSampler.h"
+#include "FixedPoint.h"
+#include "Trace.h"
+#include "Perf.h"
+#include "TwiMaster.h"
 #include <Arduino.h>
 
-SensorManager::SensorManager(SystemState& state) : _state(state) {}
+#if !ADC_ISR_MODE
+// ADC noise-reduction sleep stops clkIO, freezing the USART and TWI
+// mid-byte. Allow it only when nothing is queued for TX, the last byte has
+// left the shift register (TXC), the RX line is high and no I2C transaction
+// is running; otherwise the conversion runs awake. The RX test narrows the
+// window rather than closing it: a byte starting during the ~104 us, or one
+// caught between two 1 bits, can still be cut.
+static bool quietConversionSafe() {
+  return Serial.availableForWrite() >= SERIAL_TX_BUFFER_SIZE - 1
+      && (UCSR0A & _BV(TXC0))
+      && (PIND & _BV(PIND0))
+      && TwiMaster::idle();
+}
+#endif
+
+// Per-channel steps, expanded over SENSOR_CHANNELS by forEachChannel()
+
+struct SensorManager::SetupStep {
+    SensorManager& sm;
+    template <uint8_t I> void visit() {
+        sm._pins[I] = Channel<I>::pin;
+        sm._filters[I].configure(Channel<I>::filter);
+        DIDR0 |= _BV(Channel<I>::pin - A0);  // Digital input buffer off
+    }
+};
+
+// Blocking windows (scan, bench) and calibration windows report the window
+// as measured and leave the running filters and fault history to the
+// published readings, which all share the configured bit depth
+struct SensorManager::FinishStep {
+    SensorManager& sm;
+    bool live;
+    template <uint8_t I> void visit() {
+        sm._code[I] = decimate(sm._acqSum[I], sm._acqCount[I], sm._acqBits);
+        sm._raw[I] = sm.toCentiDegrees(sm._code[I], sm._acqBits);
+        centi_t calibrated = sm._calibration.apply(Channel<I>::calSlot, sm._raw[I]);
+        if (!live) {
+            sm._reading[I] = calibrated;
+            return;
+        }
+        sm._fault[I] = sm._faultDetectors[I].check(sm._acqMin[I], sm._acqMax[I], sm._code[I],
+                                                   sm._raw[I], sm.codeStep(),
+                                                   sm.referenceMillivolts(), millis());
+        sm._reading[I] = sm._filters[I].update(calibrated);
+        if (sm._state.debugMode && trace.begin()) {
+            sm.printReading<I>(trace);
+        }
+    }
+};
+
+struct SensorManager::DetailStep {
+    SensorManager& sm;
+    template <uint8_t I> void visit() {
+        sm.printReading<I>(Serial);
+    }
+};
+
+struct SensorManager::TestStep {
+    SensorManager& sm;
+    template <uint8_t I> void visit() {
+        printChannelName(Serial, Channel<I>::role, Channel<I>::pin);
+        Serial.print(F(" Sensor: T="));
+        printCenti(Serial, sm._reading[I], 1);
+        Serial.println(F("°C"));
+    }
+};
+
+struct SensorManager::StatusStep {
+    SensorManager& sm;
+    template <uint8_t I> void visit() {
+        printChannelName(Serial, Channel<I>::role, Channel<I>::pin);
+        Serial.print(F(" Temp: "));
+        printCenti(Serial, sm._state.channelTemp[I], 1);
+        Serial.print(F("°C"));
+        if (sm._state.channelFault[I] != FAULT_NONE) {
+            Serial.print(F(" FAULT: "));
+            Serial.print(faultName(sm._state.channelFault[I]));
+        }
+        if (sm._filters[I].kind() != FILTER_NONE) {
+            Serial.print(F(" ["));
+            printFilterName(Serial, sm._filters[I].kind());
+            Serial.print(']');
+        }
+        Serial.println();
+    }
+};
+
+struct SensorManager::CalibrationStep {
+    SensorManager& sm;
+    template <uint8_t I> void visit() {
+        Serial.print(F("  "));
+        printChannelName(Serial, Channel<I>::role, Channel<I>::pin);
+        Serial.print(F(" points:"));
+        uint8_t count = sm._calibration.pointCount(Channel<I>::calSlot);
+        if (count == 0) {
+            Serial.print(F(" none"));
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            Calibration::Point point = sm._calibration.point(Channel<I>::calSlot, i);
+            Serial.print(' ');
+            printCenti(Serial, point.measured, 2);
+            Serial.print(F("->"));
+            printCenti(Serial, point.reference, 2);
+        }
+        Serial.println();
+    }
+};
+
+struct SensorManager::CaptureStep {
+    SensorManager& sm;
+    template <uint8_t I> void visit() {
+        sm._calibration.addPoint(Channel<I>::calSlot, sm._raw[I], sm._calJobReference);
+        Serial.print(F("✓ Calibration point saved: "));
+        printCenti(Serial, sm._raw[I], 2);
+        Serial.print(F("°C -> "));
+        printCenti(Serial, sm._calJobReference, 2);
+        Serial.println(F("°C"));
+    }
+};
+
+struct SensorManager::ClearStep {
+    SensorManager& sm;
+    template <uint8_t I> void visit() {
+        sm._calibration.clear(Channel<I>::calSlot);
+    }
+};
+
+SensorManager::SensorManager(SystemState& state)
+    : _state(state)
+#if ENABLE_DS18B20
+    , _oneWire(ONEWIRE_PIN)
+#endif
+#if ENABLE_HUMIDITY
+    , _humidity(HUMIDITY_ADDRESS)
+#endif
+{}
 
 void SensorManager::begin() {
-    // Initialization if needed
+    forEachChannel(SetupStep{*this});
+    if (!_calibration.load()) {
+        Serial.println(F("No sensor calibration stored, using raw readings"));
+    }
+    setVrefMode(_vrefMode);
+#if ENABLE_DS18B20
+    Serial.print(F("DS18B20 probes: "));
+    Serial.println(_oneWire.discover());
+#endif
+#if ENABLE_HUMIDITY
+    if (!_humidity.begin()) {
+        Serial.println(F("No humidity sensor found"));
+    }
+#endif
 }
 
-void SensorManager::update() {
-    if (_state.fakeMode) {
+void SensorManager::setVrefMode(VrefMode mode) {
+    _vrefMode = mode;
+    _vrefChangedMs = millis();
+#if ADC_ISR_MODE
+    AdcSampler::begin(_pins, SENSOR_CHANNEL_COUNT, ADC_SAMPLE_RATE_HZ, referenceBits(),
+                      mode == VREF_AVCC_BANDGAP ? BANDGAP_ROTATIONS : 0);
+#else
+    AdcSampler::select(muxForChannel(0));  // Start AREF moving to the new level
+#endif
+    if (_acqState == ACQ_SAMPLING) {
+        startWindow(_acqBits);
+    }
+}
+
+SensorManager::VrefMode SensorManager::vrefMode() const {
+    return _vrefMode;
+}
+
+uint16_t SensorManager::vccMillivolts() const {
+    return _vccMillivolts;
+}
+
+uint8_t SensorManager::referenceBits() const {
+    return _vrefMode == VREF_INTERNAL_1V1 ? AdcSampler::REF_INTERNAL_1V1 : AdcSampler::REF_AVCC;
+}
+
+uint8_t SensorManager::muxForChannel(uint8_t channel) const {
+    if (channel == BANDGAP_CHANNEL) {
+        return referenceBits() | AdcSampler::MUX_BANDGAP;
+    }
+    return AdcSampler::muxFor(_pins[channel], referenceBits());
+}
+
+uint16_t SensorManager::referenceMillivolts() const {
+    switch (_vrefMode) {
+        case VREF_AVCC_BANDGAP: if (_vccMillivolts) return _vccMillivolts; break;
+        case VREF_INTERNAL_1V1: return BANDGAP_MV;
+        default:                break;
+    }
+    return REFERENCE_VOLTAGE * 1000;
+}
+
+// Vcc = Vbandgap * 1024 / code when the bandgap is read against AVcc
+void SensorManager::updateVcc(uint16_t bandgapCode) {
+    if (bandgapCode == 0) {
+        return;
+    }
+    uint16_t vcc = (uint32_t)BANDGAP_MV * 1024 / bandgapCode;
+    // Light smoothing: a single bandgap conversion is only good to ~0.5%
+    _vccMillivolts = _vccMillivolts ? ((uint32_t)_vccMillivolts * 3 + vcc) / 4 : vcc;
+}
+
+void SensorManager::requestReading() {
+    _readingRequested = true;
+#if ENABLE_DS18B20
+    if (!_state.fakeMode) {
+        _oneWire.startConversion();
+    }
+#endif
+#if ENABLE_HUMIDITY
+    _humidity.startMeasurement();
+#endif
+}
+
+bool SensorManager::isBusy() const {
+    return _acqState != ACQ_IDLE;
+}
+
+bool SensorManager::update() {
+    PerfScope perf(PERF_SENSOR_UPDATE);
+    bool published = false;
+    if (_state.fakeMode && _readingRequested) {
+        _readingRequested = false;
         addRealisticFluctuation();
-        _state.roomTemp = _fakeRoomTemp;
-        _state.algaeTemp = _fakeAlgaeTemp;
-    } else {
-        _state.roomTemp = readLM35(ROOM_TEMP_PIN);
-        _state.algaeTemp = readLM35(ALGAE_TEMP_PIN);
+        _state.roomTemp = _state.channelTemp[ROOM_CHANNEL] = _fakeRoomTemp;
+        _state.algaeTemp = _state.channelTemp[ALGAE_CHANNEL] = _fakeAlgaeTemp;
+        for (uint8_t ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+            _state.channelFault[ch] = FAULT_NONE;
+        }
+        _state.roomFault = _state.algaeFault = FAULT_NONE;
+        notePublished();
+        published = true;
+    }
+#if ENABLE_DS18B20
+    _oneWire.poll();
+#endif
+#if ENABLE_HUMIDITY
+    _humidity.poll();
+#endif
+
+    if (_acqState == ACQ_IDLE) {
+        if (_calJob != CAL_JOB_NONE) {
+            _calJobRunning = true;
+            startWindow(MAX_OVERSAMPLE_BITS);
+        } else if (_readingRequested) {
+            startWindow(_oversampleBits);
+        } else {
+            return published;
+        }
+    }
+    if (!pollWindow()) {
+        return published;
+    }
+
+    // A calibration window is taken at MAX_OVERSAMPLE_BITS and only feeds
+    // the job; a pending reading request gets its own window next
+    if (_calJobRunning) {
+        finishCalibrationJob();
+        return published;
+    }
+    if (_state.fakeMode) {
+        return published;
+    }
+    _readingRequested = false;
+    for (uint8_t ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+        _state.channelTemp[ch] = _reading[ch];
+        _state.channelFault[ch] = _fault[ch];
+    }
+    _state.roomTemp = _reading[ROOM_CHANNEL];
+    _state.roomFault = _fault[ROOM_CHANNEL];
+    _state.algaeTemp = _reading[ALGAE_CHANNEL];
+    _state.algaeFault = _fault[ALGAE_CHANNEL];
+#if ENABLE_DS18B20
+    publishProbes();
+#endif
+#if ENABLE_HUMIDITY
+    // Measured in parallel with the window; a 16 ms conversion is long done
+    _state.humidityValid = _humidity.valid();
+    _state.humidity = _humidity.humidity();
+    _state.dewPoint = _humidity.dewPoint();
+#endif
+    notePublished();
+    return true;
+}
+
+// One decimated code of the last window in centi-degrees, rounded up: ~13
+// at 12 bits and 5 V, ~49 with oversampling off
+uint16_t SensorManager::codeStep() const {
+    uint8_t shift = 10 + _acqBits;
+    return ((uint32_t)referenceMillivolts() * 10 + (1UL << shift) - 1) >> shift;
+}
+
+void SensorManager::notePublished() {
+    _interval.setResolution(codeStep());
+    _interval.setMinInterval(windowMs(_oversampleBits));
+    _interval.update(_state.roomTemp, _state.roomFault == FAULT_NONE,
+                     _state.algaeTemp, _state.algaeFault == FAULT_NONE, millis());
+}
+
+unsigned long SensorManager::readingInterval() const {
+    return _interval.interval();
+}
+
+AdaptiveInterval& SensorManager::adaptiveInterval() {
+    return _interval;
+}
+
+#if ENABLE_HUMIDITY
+const HumiditySensor& SensorManager::humiditySensor() const {
+    return _humidity;
+}
+#endif
+
+#if ENABLE_DS18B20
+// A DS18B20 probe assigned to a role replaces the LM35 for that role. Its value
+// is the last completed conversion, so it may lag the analog channels by one
+// reading interval.
+void SensorManager::publishProbes() {
+    int8_t probe = _oneWire.probeForRole(ROLE_ROOM);
+    if (probe >= 0) {
+        _state.roomTemp = _oneWire.temperature(probe);
+        _state.roomFault = _oneWire.fault(probe);
+    }
+    probe = _oneWire.probeForRole(ROLE_ALGAE);
+    if (probe >= 0) {
+        _state.algaeTemp = _oneWire.temperature(probe);
+        _state.algaeFault = _oneWire.fault(probe);
+    }
+}
+
+Ds18b20Bus& SensorManager::oneWire() {
+    return _oneWire;
+}
+#endif
+
+uint8_t SensorManager::windowSamples(uint8_t bits) {
+    // n extra bits need 4^n samples; without oversampling keep the boxcar
+    return bits == 0 ? SAMPLES_PER_READ : (uint8_t)(1 << (2 * bits));
+}
+
+// How long a window at this depth takes to fill, all channels included
+uint16_t SensorManager::windowMs(uint8_t bits) const {
+    uint16_t conversions = windowSamples(bits) * SENSOR_CHANNEL_COUNT;
+#if ADC_ISR_MODE
+    return (uint32_t)conversions * 1000 / ADC_SAMPLE_RATE_HZ;
+#else
+    if (_vrefMode == VREF_AVCC_BANDGAP) {
+        conversions++;  // The window's bandgap conversion
+    }
+    return conversions * SAMPLE_SPACING_MS;
+#endif
+}
+
+// Reduces a window sum to a (10 + bits)-bit ADC code
+uint16_t SensorManager::decimate(long sum, uint8_t count, uint8_t bits) {
+    if (bits == 0) {
+        return (sum + count / 2) / count;
+    }
+    return sum >> bits;
+}
+
+bool SensorManager::setOversampleBits(uint8_t bits) {
+    if (bits > MAX_OVERSAMPLE_BITS) {
+        return false;
+    }
+    _oversampleBits = bits;
+    return true;
+}
+
+uint8_t SensorManager::oversampleBits() const {
+    return _oversampleBits;
+}
+
+void SensorManager::startWindow(uint8_t bits) {
+    _acqState = ACQ_SAMPLING;
+    _acqBits = bits;
+    _acqTarget = windowSamples(bits);
+    for (uint8_t ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+        _acqCount[ch] = 0;
+        _acqSum[ch] = 0;
+        _acqMin[ch] = 0xFFFF;
+        _acqMax[ch] = 0;
     }
+#if ADC_ISR_MODE
+    AdcSampler::clear();  // Only use conversions taken after the request
+#else
+    // One bandgap conversion per window keeps the Vcc estimate current
+    _acqChannel = _vrefMode == VREF_AVCC_BANDGAP ? BANDGAP_CHANNEL : 0;
+    AdcSampler::select(muxForChannel(_acqChannel));
+    _lastSampleMs = millis();
+#endif
 }
 
-float SensorManager::readLM35(int pin) {
-  long sum = 0;
-  for (int i = 0; i < SAMPLES_PER_READ; i++) {
-    sum += analogRead(pin);
-    delay(10);
+// Returns true once every channel has a fresh average in _reading.
+bool SensorManager::pollWindow() {
+  if (_acqState != ACQ_SAMPLING) {
+    return false;
   }
-  
-  float avgReading = sum / (float)SAMPLES_PER_READ;
-  float voltage = (avgReading / ADC_RESOLUTION) * REFERENCE_VOLTAGE;
-  float temperature = voltage * 100.0;
-  
-  if (_state.debugMode) {
-    Serial.print(F("  [Pin "));
-    Serial.print(pin);
-    Serial.print(F("] ADC: "));
-    Serial.print(avgReading, 1);
-    Serial.print(F(" | Voltage: "));
-    Serial.print(voltage, 3);
-    Serial.print(F("V | Temp: "));
-    Serial.print(temperature, 2);
-    Serial.println(F("°C"));
+
+  // The first conversions after a reference switch read the AREF capacitor
+  // mid-transition, so nothing is used until it has settled
+  bool settling = millis() - _vrefChangedMs < REF_SETTLE_MS;
+
+#if ADC_ISR_MODE
+  if (settling) {
+    AdcSampler::clear();
+    return false;
   }
-  
-  return temperature;
+  uint8_t channel;
+  uint16_t value;
+  while (AdcSampler::read(channel, value)) {
+    if (accumulate(channel, value)) {
+      return true;
+    }
+  }
+  return false;
+#else
+  // At most one conversion per call, spaced SAMPLE_SPACING_MS apart. The
+  // next input is selected right after each conversion so the mux (and the
+  // bandgap) settle during the gap instead of costing extra conversions.
+  if (settling || millis() - _lastSampleMs < SAMPLE_SPACING_MS) {
+    return false;
+  }
+  _lastSampleMs = millis();
+
+  uint8_t channel = _acqChannel;
+  uint16_t value = _state.lowPowerMode && quietConversionSafe() ? AdcSampler::convertQuiet()
+                                                                : AdcSampler::convert();
+  _acqChannel = channel + 1 >= SENSOR_CHANNEL_COUNT ? 0 : channel + 1;
+  AdcSampler::select(muxForChannel(_acqChannel));
+  return accumulate(channel, value);
+#endif
+}
+
+bool SensorManager::accumulate(uint8_t channel, uint16_t value) {
+  if (channel == BANDGAP_CHANNEL) {
+    updateVcc(value);
+    return false;
+  }
+  if (channel >= SENSOR_CHANNEL_COUNT || _acqCount[channel] >= _acqTarget) {
+    return false;
+  }
+  _acqSum[channel] += value;
+  _acqCount[channel]++;
+  if (value < _acqMin[channel]) _acqMin[channel] = value;
+  if (value > _acqMax[channel]) _acqMax[channel] = value;
+
+  for (uint8_t ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+    if (_acqCount[ch] < _acqTarget) {
+      return false;
+    }
+  }
+
+  forEachChannel(FinishStep{*this, !_acqBlocking && !_calJobRunning});
+#if ADC_ISR_MODE
+  if (_state.debugMode && AdcSampler::dropped() > 0 && trace.begin()) {
+    trace.print(F("  [ADC] Dropped samples: "));
+    trace.println(AdcSampler::dropped());
+  }
+#endif
+  _acqState = ACQ_IDLE;
+  return true;
+}
+
+void SensorManager::acquireBlocking(uint8_t bits) {
+  _acqBlocking = true;
+  startWindow(bits);
+  while (!pollWindow()) {
+    // Interactive commands only; the main loop never waits here
+  }
+  _acqBlocking = false;
+}
+
+// LM35: 10 mV/C, so hundredths of a degree = mV * 10
+// = code * Vref_mV * 10 / 2^(10 + bits); fits 32 bits up to 13-bit codes.
+// Above 3.28 V (327.67 C) the result saturates rather than wrapping to a
+// negative centi_t, so FAULT_RANGE still sees it.
+centi_t SensorManager::toCentiDegrees(uint16_t code, uint8_t bits) const {
+  uint8_t shift = 10 + bits;
+  uint32_t scaled = (uint32_t)code * referenceMillivolts() * 10;
+  uint32_t centi = (scaled + (1UL << (shift - 1))) >> shift;
+  return centi > 32767 ? 32767 : centi;
+}
+
+template <uint8_t I>
+void SensorManager::printReading(Print& out) {
+  uint16_t code = _code[I];
+  uint8_t shift = 10 + _acqBits;
+  out.print(F("  ["));
+  printChannelName(out, Channel<I>::role, Channel<I>::pin);
+  out.print(F("] ADC: "));
+  out.print(code);
+  out.print(F(" ("));
+  out.print(shift);
+  out.print(F("-bit) | Voltage: "));
+  out.print((uint16_t)(((uint32_t)code * referenceMillivolts()) >> shift));
+  out.print(F("mV | Temp: "));
+  printCenti(out, _raw[I], 2);
+  out.print(F("°C"));
+  if (_fault[I] != FAULT_NONE) {
+    out.print(F(" | Fault: "));
+    out.print(faultName(_fault[I]));
+  }
+  if (_calibration.pointCount(Channel<I>::calSlot) > 0 || _filters[I].kind() != FILTER_NONE) {
+    out.print(F(" | Output: "));
+    printCenti(out, _reading[I], 2);
+    out.print(F("°C"));
+  }
+  out.println();
 }
 
 void SensorManager::addRealisticFluctuation() {
-  float roomVariation = random(-50, 51) / 100.0;
-  float algaeVariation = random(-50, 51) / 100.0;
-  
-  _fakeRoomTemp += roomVariation;
-  _fakeAlgaeTemp += algaeVariation;
+  _fakeRoomTemp += random(-50, 51);
+  _fakeAlgaeTemp += random(-50, 51);
   
-  static float baseRoom = 24.0;
-  static float baseAlgae = 22.0;
+  static centi_t baseRoom = 2400;
+  static centi_t baseAlgae = 2200;
   static bool baseSet = false;
   
   if (!baseSet) {
@@ -63,66 +537,180 @@ void SensorManager::addRealisticFluctuation() {
     baseSet = true;
   }
   
-  if (abs(_fakeRoomTemp - baseRoom) > 2.0) {
-    _fakeRoomTemp = baseRoom + random(-200, 201) / 100.0;
+  if (abs(_fakeRoomTemp - baseRoom) > 200) {
+    _fakeRoomTemp = baseRoom + random(-200, 201);
   }
-  if (abs(_fakeAlgaeTemp - baseAlgae) > 2.0) {
-    _fakeAlgaeTemp = baseAlgae + random(-200, 201) / 100.0;
+  if (abs(_fakeAlgaeTemp - baseAlgae) > 200) {
+    _fakeAlgaeTemp = baseAlgae + random(-200, 201);
   }
 }
 
 void SensorManager::test() {
   Serial.println(F("--- LM35 Sensor Test ---"));
-  Serial.print(F("Room Sensor (Pin A0): "));
-  float roomTemp = readLM35(ROOM_TEMP_PIN);
-  Serial.print(F("T="));
-  Serial.print(roomTemp, 1);
-  Serial.println(F("°C"));
-
-  Serial.print(F("Algae Sensor (Pin A1): "));
-  float algaeTemp = readLM35(ALGAE_TEMP_PIN);
-  Serial.print(F("T="));
-  Serial.print(algaeTemp, 1);
-  Serial.println(F("°C"));
+  acquireBlocking(_oversampleBits);
+  forEachChannel(TestStep{*this});
   Serial.println(F("--- Test Complete ---\n"));
 }
 
+// Calibration runs as a background job: the next idle window is taken at
+// full oversampling and handled in finishCalibrationJob() when it completes.
 void SensorManager::calibrate() {
+  _calJob = CAL_JOB_REPORT;
+  Serial.println(F("Calibration reading queued..."));
+}
+
+bool SensorManager::captureCalibrationPoint(uint8_t channel, centi_t reference) {
+  if (channel >= SENSOR_CHANNEL_COUNT) {
+    return false;
+  }
+  _calJob = CAL_JOB_CAPTURE;
+  _calJobChannel = channel;
+  _calJobReference = reference;
+  return true;
+}
+
+bool SensorManager::clearCalibration(uint8_t channel) {
+  if (channel >= SENSOR_CHANNEL_COUNT) {
+    return false;
+  }
+  visitChannel(channel, ClearStep{*this});
+  _calibration.save();
+  return true;
+}
+
+void SensorManager::finishCalibrationJob() {
+  CalJob job = _calJob;
+  _calJob = CAL_JOB_NONE;
+  _calJobRunning = false;
+
+  if (job == CAL_JOB_CAPTURE) {
+    visitChannel(_calJobChannel, CaptureStep{*this});
+    _calibration.save();
+    return;
+  }
+
   Serial.println(F("\n=== LM35 CALIBRATION INFO ==="));
-  Serial.println(F("Current Readings (averaged over 50 samples):"));
-  
-  long roomSum = 0;
-  for (int i = 0; i < 50; i++) {
-    roomSum += analogRead(ROOM_TEMP_PIN);
-    delay(10);
-  }
-  float roomAvg = roomSum / 50.0;
-  float roomVolt = (roomAvg / ADC_RESOLUTION) * REFERENCE_VOLTAGE;
-  float roomTemp = roomVolt * 100.0;
-  
-  Serial.print(F("Room (A0): ADC="));
-  Serial.print(roomAvg, 1);
-  Serial.print(F(", Voltage="));
-  Serial.print(roomVolt, 3);
-  Serial.print(F("V, Temp="));
-  Serial.print(roomTemp, 2);
-  Serial.println(F("°C"));
-  
-  long algaeSum = 0;
-  for (int i = 0; i < 50; i++) {
-    algaeSum += analogRead(ALGAE_TEMP_PIN);
-    delay(10);
-  }
-  float algaeAvg = algaeSum / 50.0;
-  float algaeVolt = (algaeAvg / ADC_RESOLUTION) * REFERENCE_VOLTAGE;
-  float algaeTemp = algaeVolt * 100.0;
-  
-  Serial.print(F("Algae (A1): ADC="));
-  Serial.print(algaeAvg, 1);
-  Serial.print(F(", Voltage="));
-  Serial.print(algaeVolt, 3);
-  Serial.print(F("V, Temp="));
-  Serial.print(algaeTemp, 2);
-  Serial.println(F("°C"));
+  Serial.println(F("Current Readings (64 samples, 13-bit):"));
+  forEachChannel(DetailStep{*this});
+  printCalibration();
   Serial.println(F("================================\n"));
 }
+
+bool SensorManager::setFilter(uint8_t channel, FilterKind kind, uint8_t param) {
+  if (channel >= SENSOR_CHANNEL_COUNT) {
+    return false;
+  }
+  _filters[channel].configure(kind, param);
+  return true;
+}
+
+void SensorManager::printCalibration() {
+  forEachChannel(CalibrationStep{*this});
+}
+
+void SensorManager::printChannels() {
+  forEachChannel(StatusStep{*this});
+}
+
+// Compares oversampling settings on the room channel: spread of repeated
+// readings against the time one window takes at the current sample spacing.
+void SensorManager::benchmarkOversampling() {
+  const uint8_t runs = 8;
+  Serial.println(F("\n=== ADC OVERSAMPLING BENCHMARK ==="));
+  Serial.println(F("bits samples  ms/window  LSB(C)  stddev(C)"));
+
+  for (uint8_t bits = 0; bits <= MAX_OVERSAMPLE_BITS; bits++) {
+    float mean = 0;
+    float m2 = 0;
+    unsigned long start = millis();
+    for (uint8_t i = 0; i < runs; i++) {
+      acquireBlocking(bits);
+      // Welford's running variance
+      float celsius = _reading[ROOM_CHANNEL] / 100.0;
+      float delta = celsius - mean;
+      mean += delta / (i + 1);
+      m2 += delta * (celsius - mean);
+    }
+    unsigned long windowMs = (millis() - start) / runs;
+
+    Serial.print(10 + bits);
+    Serial.print(F("   "));
+    Serial.print(windowSamples(bits));
+    Serial.print(F("       "));
+    Serial.print(windowMs);
+    Serial.print(F("       "));
+    Serial.print(referenceMillivolts() / 10.0 / (1024UL << bits), 3);
+    Serial.print(F("   "));
+    Serial.println(sqrt(m2 / (runs - 1)), 3);
+  }
+  Serial.println(F("(ms/window covers all channels)"));
+  Serial.println(F("==================================\n"));
+}
+
+// Cost of turning one window sum into a temperature: the original float
+// expression against the integer decimate + scale path. Inputs are volatile
+// so neither side is constant-folded; the loop overhead is included in both.
+void SensorManager::benchmarkConversion() {
+  const uint16_t iterations = 500;
+  volatile long sum = 16 * 153L;  // ~30 C on a 12-bit window
+  volatile uint8_t count = 16;
+  volatile float floatSink = 0;
+  volatile centi_t intSink = 0;
+
+  Serial.println(F("\n=== CONVERSION BENCHMARK ==="));
+
+  unsigned long start = micros();
+  for (uint16_t i = 0; i < iterations; i++) {
+    float avgReading = sum / (float)count;
+    float voltage = (avgReading / ADC_RESOLUTION) * REFERENCE_VOLTAGE;
+    floatSink = voltage * 100.0;
+  }
+  unsigned long floatUs = micros() - start;
+
+  start = micros();
+  for (uint16_t i = 0; i < iterations; i++) {
+    intSink = toCentiDegrees(decimate(sum, count, 2), 2);
+  }
+  unsigned long intUs = micros() - start;
+
+  Serial.print(F("float:   "));
+  Serial.print(floatUs * clockCyclesPerMicrosecond() / iterations);
+  Serial.println(F(" cycles/reading"));
+  Serial.print(F("integer: "));
+  Serial.print(intUs * clockCyclesPerMicrosecond() / iterations);
+  Serial.println(F(" cycles/reading"));
+  Serial.print(F("(results: "));
+  Serial.print(floatSink, 2);
+  Serial.print(F(" vs "));
+  printCenti(Serial, intSink, 2);
+  Serial.println(F(")"));
+  Serial.println(F("============================\n"));
+}
+
+// Cycles per sample for each filter kind on synthetic noisy input. The input
+// generator runs in every pass, so the FILTER_NONE row is the baseline.
+void SensorManager::benchmarkFilters() {
+  const uint16_t iterations = 500;
+  volatile centi_t sink = 0;
+
+  Serial.println(F("\n=== FILTER BENCHMARK ==="));
+  for (uint8_t kind = FILTER_NONE; kind <= FILTER_KALMAN; kind++) {
+    ChannelFilter filter;
+    filter.configure((FilterKind)kind);
+    uint16_t noise = 1;
+
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+      noise = noise * 109 + 89;  // Cheap LCG for +/-0.32 C jitter
+      sink = filter.update(2500 + (int8_t)(noise >> 8) / 4);
+    }
+    unsigned long elapsed = micros() - start;
+
+    printFilterName(Serial, (FilterKind)kind);
+    Serial.print(F(": "));
+    Serial.print(elapsed * clockCyclesPerMicrosecond() / iterations);
+    Serial.println(F(" cycles/sample"));
+  }
+  (void)sink;
+  Serial.println(F("========================\n"));
+}
@@ -1,18 +1,129 @@
 // src/SensorManager.h
 #pragma once
+#include <stdint.h>
 #include "State.h"
+#include "Config.h"
+#include "FixedPoint.h"
+#include "Calibration.h"
+#include "ChannelTable.h"
+#include "Ds18b20Bus.h"
+#include "HumiditySensor.h"
+#include "AdaptiveInterval.h"
 
 class SensorManager {
 public:
     SensorManager(SystemState& state);
     void begin();
-    void update();
+    // Non-blocking; call every loop(). Returns true when a new reading was published.
+    bool update();
+    void requestReading();
+    bool isBusy() const;
     void test();
+    // Calibration work is queued and completes in the background via update()
     void calibrate();
+    bool captureCalibrationPoint(uint8_t channel, centi_t reference);
+    bool clearCalibration(uint8_t channel);
+    void printCalibration();
+    void printChannels();
+    void benchmarkOversampling();
+    void benchmarkConversion();
+    void benchmarkFilters();
+    bool setFilter(uint8_t channel, FilterKind kind, uint8_t param);
+    bool setOversampleBits(uint8_t bits);
+    uint8_t oversampleBits() const;
+
+    enum VrefMode : uint8_t {
+        VREF_AVCC,          // AVcc assumed to be REFERENCE_VOLTAGE
+        VREF_AVCC_BANDGAP,  // AVcc measured against the internal bandgap
+        VREF_INTERNAL_1V1   // Internal 1.1 V reference, 0-110 C range
+    };
+    void setVrefMode(VrefMode mode);
+    VrefMode vrefMode() const;
+    uint16_t vccMillivolts() const;
+    // Time main should leave between requestReading() calls
+    unsigned long readingInterval() const;
+    AdaptiveInterval& adaptiveInterval();
+#if ENABLE_DS18B20
+    Ds18b20Bus& oneWire();
+#endif
+#if ENABLE_HUMIDITY
+    const HumiditySensor& humiditySensor() const;
+#endif
+
+    static const uint8_t MAX_OVERSAMPLE_BITS = 3;
 private:
+    enum AcqState : uint8_t { ACQ_IDLE, ACQ_SAMPLING };
+    enum CalJob : uint8_t { CAL_JOB_NONE, CAL_JOB_REPORT, CAL_JOB_CAPTURE };
+    static const uint8_t BANDGAP_CHANNEL = SENSOR_CHANNEL_COUNT;
+
+    struct SetupStep;
+    struct FinishStep;
+    struct DetailStep;
+    struct TestStep;
+    struct StatusStep;
+    struct CalibrationStep;
+    struct CaptureStep;
+    struct ClearStep;
+
     SystemState& _state;
-    float _fakeRoomTemp = 24.0;
-    float _fakeAlgaeTemp = 22.0;
-    float readLM35(int pin);
+    centi_t _fakeRoomTemp = 2400;
+    centi_t _fakeAlgaeTemp = 2200;
+    bool _readingRequested = false;
+
+    Calibration _calibration;
+    CalJob _calJob = CAL_JOB_NONE;
+    bool _calJobRunning = false;
+    uint8_t _calJobChannel = 0;
+    centi_t _calJobReference = 0;
+
+    // Sampling window state; channels are sampled round-robin and each
+    // accumulates until it holds _acqTarget samples
+    AcqState _acqState = ACQ_IDLE;
+    bool _acqBlocking = false;  // acquireBlocking(): unfiltered, no fault checks
+    uint8_t _acqChannel = 0;
+    uint8_t _oversampleBits = OVERSAMPLE_BITS;
+    uint8_t _acqBits = 0;
+    uint8_t _acqTarget = SAMPLES_PER_READ;
+    uint8_t _pins[SENSOR_CHANNEL_COUNT];
+    uint8_t _acqCount[SENSOR_CHANNEL_COUNT] = {};
+    long _acqSum[SENSOR_CHANNEL_COUNT] = {};
+    uint16_t _acqMin[SENSOR_CHANNEL_COUNT] = {};
+    uint16_t _acqMax[SENSOR_CHANNEL_COUNT] = {};
+    unsigned long _lastSampleMs = 0;
+
+    VrefMode _vrefMode = (VrefMode)DEFAULT_VREF_MODE;
+    uint16_t _vccMillivolts = 0;  // 0 until the first bandgap conversion
+    unsigned long _vrefChangedMs = 0;
+    uint16_t _code[SENSOR_CHANNEL_COUNT] = {};  // Decimated, (10 + _acqBits) bits
+    centi_t _raw[SENSOR_CHANNEL_COUNT] = {};    // Before calibration
+    centi_t _reading[SENSOR_CHANNEL_COUNT] = {};  // Calibrated and filtered
+    ChannelFilter _filters[SENSOR_CHANNEL_COUNT];
+    FaultDetector _faultDetectors[SENSOR_CHANNEL_COUNT];
+    SensorFault _fault[SENSOR_CHANNEL_COUNT] = {};
+    AdaptiveInterval _interval;
+#if ENABLE_DS18B20
+    Ds18b20Bus _oneWire;
+    void publishProbes();
+#endif
+#if ENABLE_HUMIDITY
+    HumiditySensor _humidity;
+#endif
+
+    static uint8_t windowSamples(uint8_t bits);
+    uint16_t windowMs(uint8_t bits) const;
+    static uint16_t decimate(long sum, uint8_t count, uint8_t bits);
+    void startWindow(uint8_t bits);
+    bool pollWindow();
+    uint8_t referenceBits() const;
+    uint8_t muxForChannel(uint8_t channel) const;
+    uint16_t referenceMillivolts() const;
+    uint16_t codeStep() const;
+    void updateVcc(uint16_t bandgapCode);
+    bool accumulate(uint8_t channel, uint16_t value);
+    void acquireBlocking(uint8_t bits);
+    centi_t toCentiDegrees(uint16_t code, uint8_t bits) const;
+    template <uint8_t I> void printReading(Print& out);
+    void finishCalibrationJob();
+    void notePublished();
     void addRealisticFluctuation();
 };
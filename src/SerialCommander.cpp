@@ -1,74 +1,536 @@
 // src/SerialCommander.cpp
 #include "SerialCommander.h"
 #include <Arduino.h>
-#include <Wire.h>
+#include <avr/pgmspace.h>
+#include "TwiMaster.h"
 #include "Config.h"
+#include "FixedPoint.h"
+#include "Trace.h"
+#include "Perf.h"
 
-SerialCommander::SerialCommander(SystemState& state, SensorManager& sensorManager) : _state(state), _sensorManager(sensorManager) {}
+// First words, matched exactly or by unambiguous abbreviation
+const SerialCommander::Command SerialCommander::COMMANDS[] PROGMEM = {
+    { "scan",       &SerialCommander::cmdScan },
+    { "fake",       &SerialCommander::cmdFake },
+    { "set",        &SerialCommander::cmdSet },
+    { "status",     &SerialCommander::cmdStatus },
+    { "debug",      &SerialCommander::cmdDebug },
+    { "power",      &SerialCommander::cmdPower },
+    { "adaptive",   &SerialCommander::cmdAdaptive },
+    { "lcd",        &SerialCommander::cmdLcd },
+    { "page",       &SerialCommander::cmdPage },
+    { "trend",      &SerialCommander::cmdTrend },
+    { "stats",      &SerialCommander::cmdStats },
+    { "calibrate",  &SerialCommander::cmdCalibrate },
+    { "cal",        &SerialCommander::cmdCal },
+    { "oversample", &SerialCommander::cmdOversample },
+    { "vref",       &SerialCommander::cmdVref },
+    { "bench",      &SerialCommander::cmdBench },
+    { "filter",     &SerialCommander::cmdFilter },
+    { "telemetry",  &SerialCommander::cmdTelemetry },
+    { "stream",     &SerialCommander::cmdStream },
+    { "tasks",      &SerialCommander::cmdTasks },
+    { "perf",       &SerialCommander::cmdPerf },
+#if ENABLE_MODBUS
+    { "modbus",     &SerialCommander::cmdModbus },
+#endif
+#if ENABLE_DS18B20
+    { "onewire",    &SerialCommander::cmdOneWire },
+#endif
+    { "help",       &SerialCommander::cmdHelp },
+};
+
+SerialCommander::SerialCommander(SystemState& state, SensorManager& sensorManager, PowerManager& powerManager,
+                                 DisplayManager& displayManager, ReadingStats& readingStats,
+                                 Telemetry& telemetry, ReadingStreamer& streamer,
+                                 Scheduler& scheduler)
+    : _state(state), _sensorManager(sensorManager), _powerManager(powerManager),
+      _displayManager(displayManager), _readingStats(readingStats), _telemetry(telemetry),
+      _streamer(streamer), _scheduler(scheduler)
+#if ENABLE_MODBUS
+    , _modbus(state, sensorManager)
+#endif
+{}
+
+void SerialCommander::begin() {
+#if ENABLE_MODBUS
+    _modbus.begin();
+#endif
+}
 
 void SerialCommander::process() {
-    if (Serial.available() > 0) {
-        String cmd = Serial.readStringUntil('\n');
-        cmd.trim();
-        cmd.toLowerCase();
-        
-        if (cmd == "scan") {
-            scanI2CDevices();
-            _sensorManager.test();
-        }
-        else if (cmd == "fake on") {
-            _state.fakeMode = true;
-            Serial.println(F("✓ Fake mode ENABLED"));
-        }
-        else if (cmd == "fake off") {
-            _state.fakeMode = false;
-            Serial.println(F("✓ Fake mode DISABLED - Using real sensors"));
-        }
-        else if (cmd.startsWith("set room ")) {
-            float temp = cmd.substring(9).toFloat();
-            if (temp > -50 && temp < 100) {
-                // This is a bit of a hack, we should have a setter in SensorManager
-                // _sensorManager.setFakeRoomTemp(temp);
-                Serial.print(F("✓ Room temp set to: "));
-                Serial.print(temp, 1);
-                Serial.println(F("°C"));
-            } else {
-                Serial.println(F("✗ Invalid temperature (-50 to 100°C)"));
-            }
-        }
-        else if (cmd.startsWith("set algae ")) {
-            float temp = cmd.substring(10).toFloat();
-            if (temp > -50 && temp < 100) {
-                // This is a bit of a hack, we should have a setter in SensorManager
-                // _sensorManager.setFakeAlgaeTemp(temp);
-                Serial.print(F("✓ Algae temp set to: "));
-                Serial.print(temp, 1);
-                Serial.println(F("°C"));
-            } else {
-                Serial.println(F("✗ Invalid temperature (-50 to 100°C)"));
-            }
-        }
-        else if (cmd == "status") {
-            printStatus();
-        }
-        else if (cmd == "debug on") {
-            _state.debugMode = true;
-            Serial.println(F("✓ Debug mode ENABLED - Showing ADC values"));
-        }
-        else if (cmd == "debug off") {
-            _state.debugMode = false;
-            Serial.println(F("✓ Debug mode DISABLED"));
-        }
-        else if (cmd == "calibrate") {
-            _sensorManager.calibrate();
-        }
-        else if (cmd == "help") {
-            printHelp();
+    Perf::mark(PERF_SERIAL_GAP);
+    PerfScope perf(PERF_SERIAL_PROCESS);
+#if ENABLE_MODBUS
+    if (_modbus.active()) {
+        _modbus.poll();
+        return;
+    }
+#endif
+    switch (_reader.poll(Serial, SERIAL_BYTES_PER_POLL)) {
+        case LineReader::LINE_READY:
+            dispatch(_reader.line());
+            break;
+        case LineReader::LINE_TOO_LONG:
+            Serial.println(F("✗ Line too long"));
+            break;
+        default:
+            break;
+    }
+}
+
+void SerialCommander::dispatch(char* line) {
+    char* args = line;
+    char* word = nextWord(args);
+    uint8_t length = strlen(word);
+    const uint8_t count = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+    int8_t found = -1;
+    uint8_t matches = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (strncmp_P(word, COMMANDS[i].name, length) != 0) {
+            continue;
         }
-        else if (cmd.length() > 0) {
-            Serial.println(F("✗ Unknown command. Type 'help' for commands."));
+        if (pgm_read_byte(&COMMANDS[i].name[length]) == '\0') {
+            found = i;  // Exact match beats any abbreviation ("cal", "calibrate")
+            matches = 1;
+            break;
         }
+        found = i;
+        matches++;
+    }
+    if (matches == 1) {
+        Command command;
+        memcpy_P(&command, &COMMANDS[found], sizeof(command));
+        (this->*command.handler)(args);
+    } else if (matches > 1) {
+        Serial.println(F("✗ Ambiguous command. Type 'help' for commands."));
+    } else {
+        Serial.println(F("✗ Unknown command. Type 'help' for commands."));
+    }
+}
+
+void SerialCommander::cmdScan(char* args) {
+    scanI2CDevices();
+    _sensorManager.test();
+}
+
+void SerialCommander::cmdFake(char* args) {
+    int8_t on = parseOnOff(nextWord(args));
+    if (on < 0) {
+        Serial.println(F("✗ Usage: fake <on|off>"));
+        return;
+    }
+    _state.fakeMode = on;
+    Serial.println(on ? F("✓ Fake mode ENABLED") : F("✓ Fake mode DISABLED - Using real sensors"));
+}
+
+void SerialCommander::cmdSet(char* args) {
+    // set <room|algae> <temp>
+    char* role = nextWord(args);
+    bool room = strcmp_P(role, PSTR("room")) == 0;
+    centi_t temp;
+    if (!room && strcmp_P(role, PSTR("algae")) != 0) {
+        Serial.println(F("✗ Usage: set <room|algae> <temp>"));
+    } else if (parseCenti(nextWord(args), temp) && temp > -5000 && temp < 10000) {
+        // This is a bit of a hack, we should have a setter in SensorManager
+        // _sensorManager.setFakeRoomTemp(temp);
+        Serial.print(room ? F("✓ Room temp set to: ") : F("✓ Algae temp set to: "));
+        printCenti(Serial, temp, 1);
+        Serial.println(F("°C"));
+    } else {
+        Serial.println(F("✗ Invalid temperature (-50 to 100°C)"));
+    }
+}
+
+void SerialCommander::cmdStatus(char* args) {
+    printStatus();
+}
+
+// debug: trace counters; debug <on|off>
+void SerialCommander::cmdDebug(char* args) {
+    char* word = nextWord(args);
+    if (*word == '\0') {
+        trace.printStats(Serial);
+        return;
+    }
+    int8_t on = parseOnOff(word);
+    if (on < 0) {
+        Serial.println(F("✗ Usage: debug [on|off]"));
+        return;
+    }
+    if (on) {
+        trace.resetStats();
+    }
+    _state.debugMode = on;
+    Serial.println(on ? F("✓ Debug mode ENABLED - Showing ADC values") : F("✓ Debug mode DISABLED"));
+}
+
+// power: report; power <on|off>: low-power mode
+void SerialCommander::cmdPower(char* args) {
+    char* word = nextWord(args);
+    if (*word == '\0') {
+        _powerManager.printReport();
+        return;
+    }
+    int8_t on = parseOnOff(word);
+    if (on < 0) {
+        Serial.println(F("✗ Usage: power [on|off]"));
+        return;
+    }
+    _state.lowPowerMode = on;
+    if (on) {
+        _powerManager.resetStats();
+    }
+    Serial.println(on ? F("✓ Low-power mode ENABLED") : F("✓ Low-power mode DISABLED"));
+}
+
+void SerialCommander::cmdAdaptive(char* args) {
+    int8_t on = parseOnOff(nextWord(args));
+    if (on < 0) {
+        Serial.println(F("✗ Usage: adaptive <on|off>"));
+        return;
+    }
+    _sensorManager.adaptiveInterval().setEnabled(on);
+    Serial.print(F("✓ Adaptive interval "));
+    Serial.println(on ? F("ENABLED") : F("DISABLED"));
+}
+
+void SerialCommander::cmdLcd(char* args) {
+    char* word = nextWord(args);
+    if (*word == '\0') {
+        _displayManager.printStats();
+    } else if (strcmp_P(word, PSTR("reset")) == 0) {
+        _displayManager.resetStats();
+        Serial.println(F("✓ LCD stats reset"));
+    } else {
+        Serial.println(F("✗ Usage: lcd [reset]"));
+    }
+}
+
+void SerialCommander::cmdPage(char* args) {
+    char* word = nextWord(args);
+    uint8_t page;
+    if (strcmp_P(word, PSTR("auto")) == 0) {
+        _displayManager.setAutoRotate(true);
+        Serial.println(F("✓ LCD pages rotate"));
+    } else if (parseUint8(word, page) && page < DisplayManager::PAGE_COUNT) {
+        _displayManager.setAutoRotate(false);
+        _displayManager.showPage(page);
+        Serial.print(F("✓ LCD page "));
+        Serial.println(page);
+    } else {
+        Serial.println(F("✗ Usage: page <0-5|auto>"));
+    }
+}
+
+void SerialCommander::cmdTrend(char* args) {
+    char* role = nextWord(args);
+    bool room = strcmp_P(role, PSTR("room")) == 0;
+    if (!room && strcmp_P(role, PSTR("algae")) != 0) {
+        Serial.println(F("✗ Usage: trend <room|algae>"));
+        return;
+    }
+    _displayManager.setTrendRole(room ? ROLE_ROOM : ROLE_ALGAE);
+    _displayManager.setAutoRotate(false);
+    _displayManager.showPage(DisplayManager::PAGE_TREND);
+    Serial.println(F("✓ LCD shows trend"));
+}
+
+void SerialCommander::cmdStats(char* args) {
+    if (strcmp_P(nextWord(args), PSTR("reset")) != 0) {
+        Serial.println(F("✗ Usage: stats reset"));
+        return;
+    }
+    _readingStats.reset();
+    Serial.println(F("✓ Session min/max, rates and fault counts reset"));
+}
+
+void SerialCommander::cmdTasks(char* args) {
+    char* word = nextWord(args);
+    if (*word == '\0') {
+        _scheduler.printStats(Serial);
+    } else if (strcmp_P(word, PSTR("reset")) == 0) {
+        _scheduler.resetStats();
+        Serial.println(F("✓ Task stats reset"));
+    } else {
+        Serial.println(F("✗ Usage: tasks [reset]"));
+    }
+}
+
+void SerialCommander::cmdPerf(char* args) {
+    char* word = nextWord(args);
+    if (*word == '\0') {
+        Perf::printReport(Serial);
+    } else if (strcmp_P(word, PSTR("reset")) == 0) {
+        Perf::reset();
+        Serial.println(F("✓ Perf histograms reset"));
+    } else {
+        Serial.println(F("✗ Usage: perf [reset]"));
+    }
+}
+
+void SerialCommander::cmdCalibrate(char* args) {
+    _sensorManager.calibrate();
+}
+
+// cal <room|algae> <temp>, cal clear <room|algae>, cal show
+void SerialCommander::cmdCal(char* args) {
+    char* word = nextWord(args);
+    if (strcmp_P(word, PSTR("show")) == 0) {
+        _sensorManager.printCalibration();
+        return;
+    }
+    bool clear = strcmp_P(word, PSTR("clear")) == 0;
+    if (clear) {
+        word = nextWord(args);
     }
+    int8_t channel = -1;
+    if (strcmp_P(word, PSTR("room")) == 0) channel = ROOM_CHANNEL;
+    else if (strcmp_P(word, PSTR("algae")) == 0) channel = ALGAE_CHANNEL;
+
+    centi_t reference;
+    if (channel < 0) {
+        Serial.println(F("✗ Usage: cal <room|algae> <temp>, cal clear <room|algae>, cal show"));
+    } else if (clear) {
+        _sensorManager.clearCalibration(channel);
+        Serial.println(F("✓ Calibration cleared"));
+    } else if (parseCenti(nextWord(args), reference)) {
+        _sensorManager.captureCalibrationPoint(channel, reference);
+        Serial.println(F("✓ Capturing calibration point..."));
+    } else {
+        Serial.println(F("✗ Invalid reference temperature"));
+    }
+}
+
+void SerialCommander::cmdOversample(char* args) {
+    uint8_t bits;
+    if (parseUint8(nextWord(args), bits) && _sensorManager.setOversampleBits(bits)) {
+        Serial.print(F("✓ Oversampling set to "));
+        Serial.print(10 + bits);
+        Serial.println(F("-bit"));
+    } else {
+        Serial.println(F("✗ Invalid oversampling (0-3 extra bits)"));
+    }
+}
+
+void SerialCommander::cmdVref(char* args) {
+    char* mode = nextWord(args);
+    if (strcmp_P(mode, PSTR("avcc")) == 0) {
+        _sensorManager.setVrefMode(SensorManager::VREF_AVCC);
+        Serial.println(F("✓ ADC reference: AVcc (assumed 5.0V)"));
+    } else if (strcmp_P(mode, PSTR("auto")) == 0) {
+        _sensorManager.setVrefMode(SensorManager::VREF_AVCC_BANDGAP);
+        Serial.println(F("✓ ADC reference: AVcc, bandgap-compensated"));
+    } else if (strcmp_P(mode, PSTR("1v1")) == 0) {
+        _sensorManager.setVrefMode(SensorManager::VREF_INTERNAL_1V1);
+        Serial.println(F("✓ ADC reference: internal 1.1V (0-110°C)"));
+    } else {
+        Serial.println(F("✗ Usage: vref <avcc|auto|1v1>"));
+    }
+}
+
+void SerialCommander::cmdBench(char* args) {
+    char* which = nextWord(args);
+    if (strcmp_P(which, PSTR("adc")) == 0) {
+        _sensorManager.benchmarkOversampling();
+    } else if (strcmp_P(which, PSTR("fixed")) == 0) {
+        _sensorManager.benchmarkConversion();
+    } else if (strcmp_P(which, PSTR("filter")) == 0) {
+        _sensorManager.benchmarkFilters();
+    } else {
+        Serial.println(F("✗ Usage: bench <adc|fixed|filter>"));
+    }
+}
+
+// filter <channel> <kind> [param]
+void SerialCommander::cmdFilter(char* args) {
+    int8_t channel = parseChannel(nextWord(args));
+    char* kindName = nextWord(args);
+    char* paramText = nextWord(args);
+    uint8_t param = 0;
+    bool paramOk = *paramText == '\0' || parseUint8(paramText, param);
+
+    int8_t kind = -1;
+    if (strcmp_P(kindName, PSTR("none")) == 0) kind = FILTER_NONE;
+    else if (strcmp_P(kindName, PSTR("ema")) == 0) kind = FILTER_EMA;
+    else if (strcmp_P(kindName, PSTR("median")) == 0) kind = FILTER_MEDIAN;
+    else if (strcmp_P(kindName, PSTR("kalman")) == 0) kind = FILTER_KALMAN;
+
+    if (channel >= 0 && kind >= 0 && paramOk &&
+        _sensorManager.setFilter(channel, (FilterKind)kind, param)) {
+        Serial.print(F("✓ Filter set to "));
+        Serial.println(kindName);
+    } else {
+        Serial.println(F("✗ Usage: filter <room|algae|0-5> <none|ema|median|kalman> [param]"));
+    }
+}
+
+// telemetry: counters; telemetry <on|off|reset>
+void SerialCommander::cmdTelemetry(char* args) {
+    char* word = nextWord(args);
+    if (*word == '\0') {
+        _telemetry.printStats(Serial);
+        return;
+    }
+    if (strcmp_P(word, PSTR("reset")) == 0) {
+        _telemetry.resetStats();
+        Serial.println(F("✓ Telemetry counters reset"));
+        return;
+    }
+    int8_t on = parseOnOff(word);
+    if (on < 0) {
+        Serial.println(F("✗ Usage: telemetry [on|off|reset]"));
+        return;
+    }
+    // Confirm before the first packet, so the reply is not mixed into frames
+    Serial.println(on ? F("✓ Binary telemetry ENABLED") : F("✓ Binary telemetry DISABLED"));
+    _telemetry.setEnabled(on);
+    if (on) {
+        _streamer.stop();
+    }
+}
+
+// stream: counters; stream off; stream <csv|json> [every] [field,field...]
+void SerialCommander::cmdStream(char* args) {
+    char* word = nextWord(args);
+    if (*word == '\0') {
+        _streamer.printStats(Serial);
+        return;
+    }
+    if (strcmp_P(word, PSTR("off")) == 0) {
+        _streamer.stop();
+        Serial.println(F("✓ Stream stopped"));
+        return;
+    }
+    ReadingStreamer::Format format = ReadingStreamer::STREAM_OFF;
+    if (strcmp_P(word, PSTR("csv")) == 0) format = ReadingStreamer::STREAM_CSV;
+    else if (strcmp_P(word, PSTR("json")) == 0) format = ReadingStreamer::STREAM_JSON;
+
+    uint8_t every = 1;
+    uint8_t fields = ReadingStreamer::ALL_FIELDS;
+    word = nextWord(args);
+    bool ok = format != ReadingStreamer::STREAM_OFF;
+    if (ok && isDigit(*word)) {
+        ok = parseUint8(word, every) && every > 0;
+        word = nextWord(args);
+    }
+    if (ok && *word != '\0') {
+        fields = ReadingStreamer::parseFields(word);
+        ok = fields != 0;
+    }
+    if (!ok || *args != '\0') {
+        Serial.println(F("✗ Usage: stream <csv|json> [every] [room,algae,delta,rh,dew,faults,interval]"));
+        return;
+    }
+    _telemetry.setEnabled(false);
+    _streamer.start(format, every, fields);
+}
+
+#if ENABLE_MODBUS
+// modbus: counters; modbus on: hand the port to the Modbus slave
+void SerialCommander::cmdModbus(char* args) {
+    char* word = nextWord(args);
+    if (*word == '\0') {
+        _modbus.printStats(Serial);
+        return;
+    }
+    if (parseOnOff(word) != 1) {
+        Serial.println(F("✗ Usage: modbus [on]"));
+        return;
+    }
+    Serial.print(F("✓ Modbus RTU slave "));
+    Serial.print(MODBUS_ADDRESS);
+    Serial.print(F(" at "));
+    Serial.print(MODBUS_BAUD);
+    Serial.println(F(" 8E1; write holding register 5 = 0 to return"));
+    _telemetry.setEnabled(false);
+    _streamer.stop();
+    _modbus.setActive(true);
+}
+#endif
+
+#if ENABLE_DS18B20
+// onewire, onewire scan, onewire assign <probe> <room|algae|none>
+void SerialCommander::cmdOneWire(char* args) {
+    Ds18b20Bus& bus = _sensorManager.oneWire();
+    char* word = nextWord(args);
+    if (*word == '\0') {
+        bus.printProbes(Serial);
+        return;
+    }
+    if (strcmp_P(word, PSTR("scan")) == 0) {
+        bus.discover();
+        bus.printProbes(Serial);
+        return;
+    }
+    uint8_t probe;
+    bool probeOk = strcmp_P(word, PSTR("assign")) == 0 && parseUint8(nextWord(args), probe) &&
+                   probe < bus.probeCount();
+    char* roleName = nextWord(args);
+    int8_t role = -1;
+    if (strcmp_P(roleName, PSTR("room")) == 0) role = ROLE_ROOM;
+    else if (strcmp_P(roleName, PSTR("algae")) == 0) role = ROLE_ALGAE;
+    else if (strcmp_P(roleName, PSTR("none")) == 0) role = ROLE_AUX;
+
+    if (probeOk && role >= 0) {
+        bus.assign(probe, (ChannelRole)role);
+        bus.printProbes(Serial);
+    } else {
+        Serial.println(F("✗ Usage: onewire assign <probe> <room|algae|none>"));
+    }
+}
+#endif
+
+void SerialCommander::cmdHelp(char* args) {
+    printHelp();
+}
+
+// Splits off the next space-separated word in place; "" at the end
+char* SerialCommander::nextWord(char*& args) {
+  char* word = args;
+  while (*args && *args != ' ') {
+    args++;
+  }
+  if (*args == ' ') {
+    *args++ = '\0';
+  }
+  return word;
+}
+
+// 1 for "on", 0 for "off", -1 otherwise
+int8_t SerialCommander::parseOnOff(const char* word) {
+  if (strcmp_P(word, PSTR("on")) == 0) return 1;
+  if (strcmp_P(word, PSTR("off")) == 0) return 0;
+  return -1;
+}
+
+// Digits only, 0-255
+bool SerialCommander::parseUint8(const char* word, uint8_t& value) {
+  uint16_t result = 0;
+  if (*word == '\0') {
+    return false;
+  }
+  for (; *word; word++) {
+    if (!isDigit(*word)) {
+      return false;
+    }
+    result = result * 10 + (*word - '0');
+    if (result > 255) {
+      return false;
+    }
+  }
+  value = result;
+  return true;
+}
+
+// Accepts a role name or a SENSOR_CHANNELS index; -1 if neither
+int8_t SerialCommander::parseChannel(const char* name) {
+  if (strcmp_P(name, PSTR("room")) == 0) return ROOM_CHANNEL;
+  if (strcmp_P(name, PSTR("algae")) == 0) return ALGAE_CHANNEL;
+  if (name[0] >= '0' && name[0] < '0' + SENSOR_CHANNEL_COUNT && name[1] == '\0') {
+    return name[0] - '0';
+  }
+  return -1;
 }
 
 void SerialCommander::printHelp() {
@@ -81,8 +543,37 @@ void SerialCommander::printHelp() {
   Serial.println(F("status            - Show current temperatures"));
   Serial.println(F("debug on          - Show ADC values and voltages"));
   Serial.println(F("debug off         - Disable debug output"));
+  Serial.println(F("debug             - Trace lines sent/dropped"));
+  Serial.println(F("power on/off      - Sleep between ticks, quiet ADC"));
+  Serial.println(F("power             - Duty cycle and energy per reading"));
+  Serial.println(F("adaptive on/off   - Reading interval follows dT/dt"));
+  Serial.println(F("lcd [reset]       - Display writes per update and latency"));
+  Serial.println(F("page <0-5|auto>   - LCD temps/delta/lo-hi/rate/faults/trend"));
+  Serial.println(F("trend room|algae  - Sparkline of the last 40 readings"));
+  Serial.println(F("stats reset       - Restart session min/max and counts"));
   Serial.println(F("calibrate         - Show detailed sensor readings"));
+  Serial.println(F("cal room 24.5     - Add reference point (room/algae)"));
+  Serial.println(F("cal clear room    - Remove calibration (room/algae)"));
+  Serial.println(F("cal show          - List stored calibration points"));
+  Serial.println(F("oversample 2      - Extra ADC bits via 4^n samples (0-3)"));
+  Serial.println(F("vref auto         - ADC ref: avcc, auto (bandgap), 1v1"));
+  Serial.println(F("bench adc         - Compare oversampling noise vs time"));
+  Serial.println(F("bench fixed       - Float vs integer conversion cycles"));
+  Serial.println(F("filter room ema 3 - Filter: none/ema/median/kalman [param]"));
+  Serial.println(F("bench filter      - Cycles per sample for each filter"));
+  Serial.println(F("telemetry on/off  - COBS binary packet per reading"));
+  Serial.println(F("stream csv 5 room,algae - Line per 5th reading; json, off"));
+  Serial.println(F("tasks [reset]     - Scheduler runs, WCET, lateness, misses"));
+  Serial.println(F("perf [reset]      - Latency p50/p99/max per section"));
+#if ENABLE_MODBUS
+  Serial.println(F("modbus [on]       - Modbus RTU slave on this port"));
+#endif
+#if ENABLE_DS18B20
+  Serial.println(F("onewire [scan]    - List (or re-search) DS18B20 probes"));
+  Serial.println(F("onewire assign 0 room - Probe role: room/algae/none"));
+#endif
   Serial.println(F("help              - Show this help menu"));
+  Serial.println(F("(First words may be abbreviated: stat, ov 2)"));
   Serial.println(F("=========================\n"));
 }
 
@@ -92,25 +583,61 @@ void SerialCommander::printStatus() {
   Serial.println(_state.fakeMode ? F("FAKE/MOCK") : F("REAL SENSORS"));
   Serial.print(F("Debug: "));
   Serial.println(_state.debugMode ? F("ON") : F("OFF"));
-  Serial.print(F("Room Temp: "));
-  Serial.print(_state.roomTemp, 1);
-  Serial.println(F("°C"));
-  Serial.print(F("Algae Temp: "));
-  Serial.print(_state.algaeTemp, 1);
-  Serial.println(F("°C"));
+  Serial.print(F("ADC: "));
+  Serial.print(10 + _sensorManager.oversampleBits());
+  Serial.print(F("-bit, Vref "));
+  switch (_sensorManager.vrefMode()) {
+    case SensorManager::VREF_AVCC:         Serial.println(F("AVcc")); break;
+    case SensorManager::VREF_AVCC_BANDGAP: Serial.println(F("AVcc (auto)")); break;
+    case SensorManager::VREF_INTERNAL_1V1: Serial.println(F("1.1V")); break;
+  }
+  if (_sensorManager.vrefMode() == SensorManager::VREF_AVCC_BANDGAP) {
+    Serial.print(F("Vcc: "));
+    Serial.print(_sensorManager.vccMillivolts());
+    Serial.println(F(" mV"));
+  }
+  AdaptiveInterval& interval = _sensorManager.adaptiveInterval();
+  Serial.print(F("Interval: "));
+  Serial.print(interval.interval());
+  Serial.print(F(" ms"));
+  if (interval.enabled()) {
+    Serial.print(F(" (adaptive, dT/dt "));
+    printCenti(Serial, interval.slewRate() > 32767 ? 32767 : interval.slewRate(), 2);
+    Serial.print(F("°C/min)"));
+  }
+  Serial.println();
+  _sensorManager.printChannels();
+#if ENABLE_HUMIDITY
+  const HumiditySensor& rh = _sensorManager.humiditySensor();
+  if (rh.present()) {
+    Serial.print(F("Humidity: "));
+    if (_state.humidityValid) {
+      printCenti(Serial, _state.humidity, 1);
+      Serial.print(F("% RH, dew point "));
+      printCenti(Serial, _state.dewPoint, 1);
+      Serial.print(F("°C (sensor "));
+      printCenti(Serial, rh.temperature(), 1);
+      Serial.println(F("°C)"));
+    } else {
+      Serial.println(faultName(FAULT_COMM));
+    }
+    if (rh.errors()) {
+      Serial.print(F("  I2C errors: "));
+      Serial.println(rh.errors());
+    }
+  }
+#endif
   Serial.println(F("====================\n"));
 }
 
 void SerialCommander::scanI2CDevices() {
   Serial.println(F("\n--- I2C Device Scanner ---"));
-  byte error, address;
+  byte address;
   int devices = 0;
   
   for (address = 1; address < 127; address++) {
-    Wire.beginTransmission(address);
-    error = Wire.endTransmission();
-    
-    if (error == 0) {
+    // Address-only write: ACK means a device is there
+    if (TwiMaster::write(address, nullptr, 0) == TwiMaster::TWI_OK) {
       Serial.print(F("I2C device found at 0x"));
       if (address < 16) Serial.print("0");
       Serial.print(address, HEX);
@@ -119,9 +646,14 @@ void SerialCommander::scanI2CDevices() {
       Serial.println(F("))"));
       devices++;
       
-      if (address == LCD_ADDRESS) {
-        Serial.println(F("  → LCD Display"));
+      if (address == DISPLAY_ADDRESS) {
+        Serial.println(F("  → Display"));
+      }
+#if ENABLE_HUMIDITY
+      if (address == HUMIDITY_ADDRESS) {
+        Serial.println(F("  → Humidity Sensor"));
       }
+#endif
     }
   }
   
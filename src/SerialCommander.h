@@ -1,16 +1,88 @@
 // src/SerialCommander.h
 #pragma once
+#include <Arduino.h>
 #include "State.h"
 #include "SensorManager.h" // To access test/calibrate
+#include "PowerManager.h"
+#include "DisplayManager.h"
+#include "ReadingStats.h"
+#include "Telemetry.h"
+#include "ReadingStreamer.h"
+#include "Scheduler.h"
+#include "ModbusSlave.h"
+#include "LineReader.h"
 
+// Serial console. Lines are collected by LineReader without blocking; the
+// first word is looked up in a PROGMEM table, either exactly or as an
+// unambiguous abbreviation ("stat" for "status"), and the rest of the line
+// is passed to the handler, which splits it with nextWord(). In Modbus mode
+// the port belongs to ModbusSlave until a master hands it back.
 class SerialCommander {
 public:
-    SerialCommander(SystemState& state, SensorManager& sensorManager);
+    SerialCommander(SystemState& state, SensorManager& sensorManager, PowerManager& powerManager,
+                    DisplayManager& displayManager, ReadingStats& readingStats, Telemetry& telemetry,
+                    ReadingStreamer& streamer, Scheduler& scheduler);
+    // Starts in Modbus mode when MODBUS_AT_BOOT
+    void begin();
+    // Non-blocking; call every loop()
     void process();
 private:
+    typedef void (SerialCommander::*Handler)(char* args);
+    struct Command {
+        char name[11];
+        Handler handler;
+    };
+    static const Command COMMANDS[];
+
     SystemState& _state;
     SensorManager& _sensorManager;
+    PowerManager& _powerManager;
+    DisplayManager& _displayManager;
+    ReadingStats& _readingStats;
+    Telemetry& _telemetry;
+    ReadingStreamer& _streamer;
+    Scheduler& _scheduler;
+    LineReader _reader;
+#if ENABLE_MODBUS
+    ModbusSlave _modbus;
+#endif
+
+    void dispatch(char* line);
     void printHelp();
     void printStatus();
     void scanI2CDevices();
+
+    void cmdScan(char* args);
+    void cmdFake(char* args);
+    void cmdSet(char* args);
+    void cmdStatus(char* args);
+    void cmdDebug(char* args);
+    void cmdPower(char* args);
+    void cmdAdaptive(char* args);
+    void cmdLcd(char* args);
+    void cmdPage(char* args);
+    void cmdTrend(char* args);
+    void cmdStats(char* args);
+    void cmdCalibrate(char* args);
+    void cmdCal(char* args);
+    void cmdOversample(char* args);
+    void cmdVref(char* args);
+    void cmdBench(char* args);
+    void cmdFilter(char* args);
+    void cmdTelemetry(char* args);
+    void cmdStream(char* args);
+    void cmdTasks(char* args);
+    void cmdPerf(char* args);
+#if ENABLE_MODBUS
+    void cmdModbus(char* args);
+#endif
+#if ENABLE_DS18B20
+    void cmdOneWire(char* args);
+#endif
+    void cmdHelp(char* args);
+
+    static char* nextWord(char*& args);
+    static int8_t parseOnOff(const char* word);
+    static bool parseUint8(const char* word, uint8_t& value);
+    static int8_t parseChannel(const char* name);
 };
@@ -0,0 +1,191 @@
+// src/Ssd1306Text.cpp
+#include "Ssd1306Text.h"
+
+#if DISPLAY_BACKEND == DISPLAY_SSD1306
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include "TwiMaster.h"
+
+constexpr uint8_t Ssd1306Text::COLS;
+constexpr uint8_t Ssd1306Text::ROWS;
+
+static const uint8_t CONTROL_COMMANDS = 0x00;
+static const uint8_t CONTROL_DATA = 0x40;
+static const uint8_t CMD_COLUMN_RANGE = 0x21;
+static const uint8_t CMD_PAGE_RANGE = 0x22;
+static const uint8_t CMD_NOP = 0xE3;
+static const uint8_t CELL_WIDTH = 8;
+static const uint8_t GLYPH_WIDTH = 5;
+static const uint8_t CHAR_PACKET = 1 + CELL_WIDTH;
+static const uint8_t DEGREE = 223;  // HD44780 code, kept so pages print the same
+
+static const uint8_t INIT_SEQUENCE[] PROGMEM = {
+    0xAE,        // Display off
+    0xD5, 0x80,  // Clock divide
+    0xA8, 0x3F,  // Multiplex: 64 rows
+    0xD3, 0x00,  // No display offset
+    0x40,        // Start line 0
+    0x8D, 0x14,  // Charge pump on
+    0x20, 0x00,  // Horizontal addressing
+    0xA1, 0xC8,  // Segment remap, COM scan descending (not mirrored)
+    0xDA, 0x12,  // COM pins for 128x64
+    0x81, 0xCF,  // Contrast
+    0xD9, 0xF1,  // Pre-charge
+    0xDB, 0x40,  // VCOMH deselect level
+    0xA4, 0xA6,  // Show RAM, not inverted
+    0xAF         // Display on
+};
+
+// Classic 5x7 ASCII font, 0x20-0x7E, one byte per column, bit 0 at the top
+static const uint8_t FONT[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00,  0x00, 0x00, 0x5F, 0x00, 0x00,  // space !
+    0x00, 0x07, 0x00, 0x07, 0x00,  0x14, 0x7F, 0x14, 0x7F, 0x14,  // " #
+    0x24, 0x2A, 0x7F, 0x2A, 0x12,  0x23, 0x13, 0x08, 0x64, 0x62,  // $ %
+    0x36, 0x49, 0x55, 0x22, 0x50,  0x00, 0x05, 0x03, 0x00, 0x00,  // & '
+    0x00, 0x1C, 0x22, 0x41, 0x00,  0x00, 0x41, 0x22, 0x1C, 0x00,  // ( )
+    0x08, 0x2A, 0x1C, 0x2A, 0x08,  0x08, 0x08, 0x3E, 0x08, 0x08,  // * +
+    0x00, 0x50, 0x30, 0x00, 0x00,  0x08, 0x08, 0x08, 0x08, 0x08,  // , -
+    0x00, 0x60, 0x60, 0x00, 0x00,  0x20, 0x10, 0x08, 0x04, 0x02,  // . /
+    0x3E, 0x51, 0x49, 0x45, 0x3E,  0x00, 0x42, 0x7F, 0x40, 0x00,  // 0 1
+    0x42, 0x61, 0x51, 0x49, 0x46,  0x21, 0x41, 0x45, 0x4B, 0x31,  // 2 3
+    0x18, 0x14, 0x12, 0x7F, 0x10,  0x27, 0x45, 0x45, 0x45, 0x39,  // 4 5
+    0x3C, 0x4A, 0x49, 0x49, 0x30,  0x01, 0x71, 0x09, 0x05, 0x03,  // 6 7
+    0x36, 0x49, 0x49, 0x49, 0x36,  0x06, 0x49, 0x49, 0x29, 0x1E,  // 8 9
+    0x00, 0x36, 0x36, 0x00, 0x00,  0x00, 0x56, 0x36, 0x00, 0x00,  // : ;
+    0x08, 0x14, 0x22, 0x41, 0x00,  0x14, 0x14, 0x14, 0x14, 0x14,  // < =
+    0x00, 0x41, 0x22, 0x14, 0x08,  0x02, 0x01, 0x51, 0x09, 0x06,  // > ?
+    0x32, 0x49, 0x79, 0x41, 0x3E,  0x7E, 0x11, 0x11, 0x11, 0x7E,  // @ A
+    0x7F, 0x49, 0x49, 0x49, 0x36,  0x3E, 0x41, 0x41, 0x41, 0x22,  // B C
+    0x7F, 0x41, 0x41, 0x22, 0x1C,  0x7F, 0x49, 0x49, 0x49, 0x41,  // D E
+    0x7F, 0x09, 0x09, 0x09, 0x01,  0x3E, 0x41, 0x49, 0x49, 0x7A,  // F G
+    0x7F, 0x08, 0x08, 0x08, 0x7F,  0x00, 0x41, 0x7F, 0x41, 0x00,  // H I
+    0x20, 0x40, 0x41, 0x3F, 0x01,  0x7F, 0x08, 0x14, 0x22, 0x41,  // J K
+    0x7F, 0x40, 0x40, 0x40, 0x40,  0x7F, 0x02, 0x0C, 0x02, 0x7F,  // L M
+    0x7F, 0x04, 0x08, 0x10, 0x7F,  0x3E, 0x41, 0x41, 0x41, 0x3E,  // N O
+    0x7F, 0x09, 0x09, 0x09, 0x06,  0x3E, 0x41, 0x51, 0x21, 0x5E,  // P Q
+    0x7F, 0x09, 0x19, 0x29, 0x46,  0x46, 0x49, 0x49, 0x49, 0x31,  // R S
+    0x01, 0x01, 0x7F, 0x01, 0x01,  0x3F, 0x40, 0x40, 0x40, 0x3F,  // T U
+    0x1F, 0x20, 0x40, 0x20, 0x1F,  0x3F, 0x40, 0x38, 0x40, 0x3F,  // V W
+    0x63, 0x14, 0x08, 0x14, 0x63,  0x07, 0x08, 0x70, 0x08, 0x07,  // X Y
+    0x61, 0x51, 0x49, 0x45, 0x43,  0x00, 0x7F, 0x41, 0x41, 0x00,  // Z [
+    0x02, 0x04, 0x08, 0x10, 0x20,  0x00, 0x41, 0x41, 0x7F, 0x00,  // backslash ]
+    0x04, 0x02, 0x01, 0x02, 0x04,  0x40, 0x40, 0x40, 0x40, 0x40,  // ^ _
+    0x00, 0x01, 0x02, 0x04, 0x00,  0x20, 0x54, 0x54, 0x54, 0x78,  // ` a
+    0x7F, 0x48, 0x44, 0x44, 0x38,  0x38, 0x44, 0x44, 0x44, 0x20,  // b c
+    0x38, 0x44, 0x44, 0x48, 0x7F,  0x38, 0x54, 0x54, 0x54, 0x18,  // d e
+    0x08, 0x7E, 0x09, 0x01, 0x02,  0x0C, 0x52, 0x52, 0x52, 0x3E,  // f g
+    0x7F, 0x08, 0x04, 0x04, 0x78,  0x00, 0x44, 0x7D, 0x40, 0x00,  // h i
+    0x20, 0x40, 0x44, 0x3D, 0x00,  0x7F, 0x10, 0x28, 0x44, 0x00,  // j k
+    0x00, 0x41, 0x7F, 0x40, 0x00,  0x7C, 0x04, 0x18, 0x04, 0x78,  // l m
+    0x7C, 0x08, 0x04, 0x04, 0x78,  0x38, 0x44, 0x44, 0x44, 0x38,  // n o
+    0x7C, 0x14, 0x14, 0x14, 0x08,  0x08, 0x14, 0x14, 0x18, 0x7C,  // p q
+    0x7C, 0x08, 0x04, 0x04, 0x08,  0x48, 0x54, 0x54, 0x54, 0x20,  // r s
+    0x04, 0x3F, 0x44, 0x40, 0x20,  0x3C, 0x40, 0x40, 0x20, 0x7C,  // t u
+    0x1C, 0x20, 0x40, 0x20, 0x1C,  0x3C, 0x40, 0x30, 0x40, 0x3C,  // v w
+    0x44, 0x28, 0x10, 0x28, 0x44,  0x0C, 0x50, 0x50, 0x50, 0x3C,  // x y
+    0x44, 0x64, 0x54, 0x4C, 0x44,  0x00, 0x08, 0x36, 0x41, 0x00,  // z {
+    0x00, 0x00, 0x7F, 0x00, 0x00,  0x00, 0x41, 0x36, 0x08, 0x00,  // | }
+    0x08, 0x04, 0x08, 0x10, 0x08                                   // ~
+};
+static_assert(sizeof(FONT) == 95 * GLYPH_WIDTH, "FONT covers 0x20-0x7E");
+
+static const uint8_t DEGREE_GLYPH[] PROGMEM = { 0x00, 0x06, 0x09, 0x09, 0x06 };
+static const uint8_t UNKNOWN_GLYPH[] PROGMEM = { 0x7F, 0x41, 0x41, 0x41, 0x7F };
+
+Ssd1306Text::Ssd1306Text(uint8_t address) : _address(address) {
+    memset(_glyphs, 0, sizeof(_glyphs));
+}
+
+void Ssd1306Text::begin() {
+    TwiMaster::setStreamAddress(_address);
+    delay(50);
+    uint8_t init[sizeof(INIT_SEQUENCE)];
+    memcpy_P(init, INIT_SEQUENCE, sizeof(init));
+    commandsBlocking(init, sizeof(init));
+
+    // Clear: whole-screen window, then 8 pages of 128 zero bytes
+    const uint8_t window[] = { CMD_COLUMN_RANGE, 0, 127, CMD_PAGE_RANGE, 0, 7 };
+    commandsBlocking(window, sizeof(window));
+    uint8_t zeros[1 + 32] = { CONTROL_DATA };
+    for (uint8_t chunk = 0; chunk < 8 * 128 / 32; chunk++) {
+        while (!TwiMaster::queuePacket(zeros, sizeof(zeros))) {
+            TwiMaster::poll();
+        }
+    }
+    while (!TwiMaster::streamIdle()) {
+        TwiMaster::poll();
+    }
+}
+
+// Window from the cell to the end of the display; consecutive writes then
+// run along the row without further commands
+bool Ssd1306Text::setCursor(uint8_t col, uint8_t row) {
+    const uint8_t packet[] = {
+        CONTROL_COMMANDS,
+        CMD_COLUMN_RANGE, (uint8_t)(col * CELL_WIDTH), 127,
+        CMD_PAGE_RANGE, (uint8_t)(row < ROWS ? row : ROWS - 1), 7
+    };
+    return TwiMaster::queuePacket(packet, sizeof(packet));
+}
+
+bool Ssd1306Text::write(uint8_t value) {
+    uint8_t packet[CHAR_PACKET] = { CONTROL_DATA };
+    if (value < 8) {
+        memcpy(packet + 1, _glyphs[value], GLYPH_WIDTH);
+    } else {
+        const uint8_t* glyph = UNKNOWN_GLYPH;
+        if (value >= 0x20 && value <= 0x7E) {
+            glyph = FONT + (value - 0x20) * GLYPH_WIDTH;
+        } else if (value == DEGREE) {
+            glyph = DEGREE_GLYPH;
+        }
+        memcpy_P(packet + 1, glyph, GLYPH_WIDTH);
+    }
+    // The remaining 3 columns stay blank as letter spacing
+    return TwiMaster::queuePacket(packet, sizeof(packet));
+}
+
+// HD44780 glyph rows (bit 4 = left column) to SSD1306 column bytes
+bool Ssd1306Text::createChar(uint8_t slot, const uint8_t* rows) {
+    uint8_t* columns = _glyphs[slot & 0x07];
+    for (uint8_t x = 0; x < GLYPH_WIDTH; x++) {
+        uint8_t column = 0;
+        for (uint8_t y = 0; y < 8; y++) {
+            if (rows[y] & (0x10 >> x)) {
+                column |= 1 << y;
+            }
+        }
+        columns[x] = column;
+    }
+    return true;
+}
+
+uint8_t Ssd1306Text::room() const {
+    return min(TwiMaster::queueFree() / CHAR_PACKET, TwiMaster::packetsFree());
+}
+
+bool Ssd1306Text::idle() const {
+    return TwiMaster::streamIdle();
+}
+
+// A cut window command (0x21/0x22 take two parameters) would swallow the
+// next packet's first bytes as its arguments: feed it NOPs instead. The
+// setCursor() that starts the redraw then sets a sane window again.
+bool Ssd1306Text::resync() {
+    const uint8_t packet[] = { CONTROL_COMMANDS, CMD_NOP, CMD_NOP };
+    return TwiMaster::queuePacket(packet, sizeof(packet));
+}
+
+// Command bytes in one-shot transactions of a control byte plus up to 7
+void Ssd1306Text::commandsBlocking(const uint8_t* commands, uint8_t count) {
+    uint8_t buffer[TwiMaster::BUFFER_SIZE];
+    buffer[0] = CONTROL_COMMANDS;
+    while (count > 0) {
+        uint8_t chunk = min(count, (uint8_t)(TwiMaster::BUFFER_SIZE - 1));
+        memcpy(buffer + 1, commands, chunk);
+        TwiMaster::write(_address, buffer, chunk + 1);
+        commands += chunk;
+        count -= chunk;
+    }
+}
+#endif  // DISPLAY_BACKEND == DISPLAY_SSD1306
@@ -0,0 +1,35 @@
+// src/Ssd1306Text.h
+#pragma once
+#include <stdint.h>
+#include "Config.h"
+
+#if DISPLAY_BACKEND == DISPLAY_SSD1306
+// 128x64 SSD1306 OLED as a 16x8 text display: each 8-pixel page is one text
+// row, each cell a 5x7 glyph in 8 columns. Glyph columns are read from
+// PROGMEM straight into TwiMaster packets, so there is no 1 KB framebuffer;
+// DisplayManager's cell diff decides which cells go out. User glyphs (codes
+// 0-7) live in RAM; unlike CGRAM, changing one does not update cells already
+// drawn, so DisplayManager redraws them (HAS_CGRAM == false).
+class Ssd1306Text {
+public:
+    static constexpr uint8_t COLS = 16;
+    static constexpr uint8_t ROWS = 8;
+    static const bool HAS_CGRAM = false;
+
+    explicit Ssd1306Text(uint8_t address);
+    // Blocking init and clear (streams the 8 pages of zeros once)
+    void begin();
+    bool setCursor(uint8_t col, uint8_t row);
+    bool write(uint8_t value);
+    bool createChar(uint8_t slot, const uint8_t* rows);
+    uint8_t room() const;
+    bool idle() const;
+    // Completes a command packet cut short by a stream error
+    bool resync();
+private:
+    uint8_t _address;
+    uint8_t _glyphs[8][5];  // User glyphs as column bytes (bit 0 = top)
+
+    void commandsBlocking(const uint8_t* commands, uint8_t count);
+};
+#endif  // DISPLAY_BACKEND == DISPLAY_SSD1306
@@ -1,9 +1,21 @@
 // src/State.h
 #pragma once
+#include "FixedPoint.h"
+#include "ChannelTable.h"
+#include "FaultDetector.h"
 
 struct SystemState {
     bool fakeMode = false;
     bool debugMode = false;
-    float roomTemp = 0.0;
-    float algaeTemp = 22.0;
+    bool lowPowerMode = false;
+    centi_t roomTemp = 0;       // Hundredths of a degree C
+    centi_t algaeTemp = 2200;
+    // Fault of whichever sensor (LM35 channel or DS18B20 probe) feeds each role
+    SensorFault roomFault = FAULT_NONE;
+    SensorFault algaeFault = FAULT_NONE;
+    centi_t channelTemp[SENSOR_CHANNEL_COUNT] = {};  // In SENSOR_CHANNELS order
+    SensorFault channelFault[SENSOR_CHANNEL_COUNT] = {};
+    bool humidityValid = false;  // False without a humidity sensor or on errors
+    centi_t humidity = 0;        // Hundredths of %RH
+    centi_t dewPoint = 0;
 };
@@ -0,0 +1,73 @@
+// src/Telemetry.cpp
+#include "Telemetry.h"
+#include "Cobs.h"
+#include "Crc16.h"
+
+static uint8_t* putChannel(uint8_t* p, centi_t value, SensorFault fault) {
+    *p++ = (uint16_t)value & 0xFF;
+    *p++ = (uint16_t)value >> 8;
+    *p++ = fault;
+    return p;
+}
+
+void Telemetry::setEnabled(bool enabled) {
+    _enabled = enabled;
+}
+
+bool Telemetry::enabled() const {
+    return _enabled;
+}
+
+void Telemetry::send(const SystemState& state, unsigned long nowMs) {
+    if (!_enabled) {
+        return;
+    }
+    uint8_t packet[PACKET_SIZE];
+    uint8_t* p = packet;
+    *p++ = PACKET_READING;
+    *p++ = TELEMETRY_NODE_ID;
+    *p++ = _seq & 0xFF;
+    *p++ = _seq >> 8;
+    for (uint8_t shift = 0; shift < 32; shift += 8) {
+        *p++ = nowMs >> shift;
+    }
+    *p++ = CHANNELS;
+    p = putChannel(p, state.roomTemp, state.roomFault);
+    p = putChannel(p, state.algaeTemp, state.algaeFault);
+#if ENABLE_HUMIDITY
+    SensorFault rhFault = state.humidityValid ? FAULT_NONE : FAULT_COMM;
+    p = putChannel(p, state.humidity, rhFault);
+    p = putChannel(p, state.dewPoint, rhFault);
+#endif
+    uint16_t crc = crc16(packet, p - packet);
+    *p++ = crc & 0xFF;
+    *p++ = crc >> 8;
+    _seq++;
+
+    uint8_t frame[PACKET_SIZE + 2];
+    uint8_t length = Cobs::encode(packet, PACKET_SIZE, frame);
+    frame[length++] = 0x00;
+    if (Serial.availableForWrite() < length) {
+        _dropped++;
+        return;
+    }
+    Serial.write(frame, length);
+    _sent++;
+}
+
+void Telemetry::printStats(Print& out) const {
+    out.print(F("Telemetry: "));
+    out.print(_enabled ? F("ON") : F("OFF"));
+    out.print(F(", node "));
+    out.print(TELEMETRY_NODE_ID);
+    out.print(F(", "));
+    out.print(_sent);
+    out.print(F(" sent, "));
+    out.print(_dropped);
+    out.println(F(" dropped"));
+}
+
+void Telemetry::resetStats() {
+    _sent = 0;
+    _dropped = 0;
+}
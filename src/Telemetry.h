@@ -0,0 +1,41 @@
+// src/Telemetry.h
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+#include "State.h"
+
+// Binary telemetry for host collectors: one COBS-framed packet per
+// published reading, terminated by 0x00, so a host resynchronises at the
+// next zero byte after any garbage (including text replies to commands).
+// Before COBS encoding a packet is, little-endian:
+//   type (1) = PACKET_READING, node (1) = TELEMETRY_NODE_ID, seq (2),
+//   timestamp ms (4), channel count n (1),
+//   n x { value (2, signed hundredths), fault (1, SensorFault) },
+//   CRC-16/MODBUS (2) over everything before it
+// Channels are room, algae, then humidity (%RH) and dew point when
+// ENABLE_HUMIDITY. A packet that does not fit in the TX buffer is dropped
+// rather than waited for; seq still advances, so the host sees the gap.
+class Telemetry {
+public:
+    static const uint8_t PACKET_READING = 0x01;
+
+    void setEnabled(bool enabled);
+    bool enabled() const;
+    // Call with each published reading; does nothing when disabled
+    void send(const SystemState& state, unsigned long nowMs);
+    void printStats(Print& out) const;
+    void resetStats();
+private:
+#if ENABLE_HUMIDITY
+    static const uint8_t CHANNELS = 4;
+#else
+    static const uint8_t CHANNELS = 2;
+#endif
+    static const uint8_t HEADER_SIZE = 9;
+    static const uint8_t PACKET_SIZE = HEADER_SIZE + CHANNELS * 3 + 2;
+
+    bool _enabled = false;
+    uint16_t _seq = 0;
+    uint16_t _sent = 0;
+    uint16_t _dropped = 0;
+};
@@ -0,0 +1,52 @@
+// src/TextFrame.h
+#pragma once
+#include <Arduino.h>
+#include <string.h>
+
+// A COLS x ROWS character frame in RAM. Pages are formatted into it with
+// the usual Print calls; text past the end of a row is dropped rather than
+// wrapping, as on the HD44780's visible window.
+template <uint8_t COLS, uint8_t ROWS>
+class TextFrame : public Print {
+public:
+    TextFrame() {
+        clear();
+    }
+
+    void clear() {
+        memset(_cells, ' ', sizeof(_cells));
+        _col = 0;
+        _row = 0;
+    }
+
+    void setCursor(uint8_t col, uint8_t row) {
+        _col = col;
+        _row = row;
+    }
+
+    size_t write(uint8_t c) override {
+        if (_row >= ROWS || _col >= COLS) {
+            return 0;
+        }
+        _cells[_row][_col++] = c;
+        return 1;
+    }
+    using Print::write;
+
+    char at(uint8_t col, uint8_t row) const {
+        return _cells[row][col];
+    }
+
+    void set(uint8_t col, uint8_t row, char c) {
+        _cells[row][col] = c;
+    }
+
+    void fill(char c) {
+        memset(_cells, c, sizeof(_cells));
+    }
+
+private:
+    char _cells[ROWS][COLS];
+    uint8_t _col = 0;
+    uint8_t _row = 0;
+};
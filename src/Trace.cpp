@@ -0,0 +1,97 @@
+// src/Trace.cpp
+#include "Trace.h"
+
+Trace trace;
+
+// A line plus the widest drop note ("[65535 dropped]" and CRLF) must fit in
+// the SERIAL_TX_BUFFER_SIZE - 1 bytes an empty ring reports free
+static_assert(TRACE_LINE_SIZE + 17 < SERIAL_TX_BUFFER_SIZE,
+              "Trace lines must fit the serial TX ring (see platformio.ini)");
+
+void Trace::refill() {
+    unsigned long now = millis();
+    uint32_t earned = (uint32_t)(now - _refillMs) * TRACE_BYTES_PER_SEC / 1000;
+    if (earned == 0) {
+        return;
+    }
+    _refillMs = now;
+    _tokens = min((uint32_t)TRACE_BURST_BYTES, _tokens + earned);
+}
+
+bool Trace::begin() {
+    refill();
+    _active = false;
+    _length = 0;
+    if (_muted) {
+        return false;
+    }
+    // The drop note goes out first, so the line needs room after it
+    char note[20];
+    uint8_t noteLength = 0;
+    if (_pendingDrops > 0) {
+        note[0] = '[';
+        utoa(_pendingDrops, note + 1, 10);
+        strcat_P(note, PSTR(" dropped]\r\n"));
+        noteLength = strlen(note);
+    }
+    uint16_t needed = TRACE_LINE_SIZE + noteLength;
+    if (_tokens < needed || Serial.availableForWrite() < (int)needed) {
+        drop();
+        return false;
+    }
+    if (noteLength > 0) {
+        Serial.write((const uint8_t*)note, noteLength);
+        _tokens -= noteLength;
+        _pendingDrops = 0;
+    }
+    _active = true;
+    return true;
+}
+
+void Trace::drop() {
+    _dropped++;
+    _pendingDrops++;
+}
+
+// begin() reserved TRACE_LINE_SIZE bytes of TX ring and budget, so writes go
+// straight to Serial without ever waiting
+size_t Trace::write(uint8_t c) {
+    if (!_active || c == '\r') {
+        return 1;
+    }
+    if (c == '\n') {
+        Serial.write('\r');
+        Serial.write('\n');
+        _tokens -= _length + 2;
+        _active = false;
+        _sent++;
+        return 1;
+    }
+    if (_length >= TRACE_LINE_SIZE - 2) {
+        return 1;  // Over-long lines are cut, keeping room for CRLF
+    }
+    Serial.write(c);
+    _length++;
+    return 1;
+}
+
+void Trace::setMuted(bool muted) {
+    _muted = muted;
+    _active = false;
+}
+
+void Trace::printStats(Print& out) const {
+    out.print(F("Trace: "));
+    out.print(_sent);
+    out.print(F(" lines sent, "));
+    out.print(_dropped);
+    out.print(F(" dropped (budget "));
+    out.print(TRACE_BYTES_PER_SEC);
+    out.println(F(" B/s)"));
+}
+
+void Trace::resetStats() {
+    _sent = 0;
+    _dropped = 0;
+    _pendingDrops = 0;
+}
@@ -0,0 +1,38 @@
+// src/Trace.h
+#pragma once
+#include <Arduino.h>
+#include "Config.h"
+
+// Debug trace that never blocks the caller. begin() admits a line only if
+// TRACE_LINE_SIZE bytes are free in the TX buffer right now and in a byte
+// budget of TRACE_BYTES_PER_SEC (burst TRACE_BURST_BYTES); the line is then
+// written straight through with the usual Print calls, so it needs no RAM
+// copy, and anything past TRACE_LINE_SIZE is cut. Otherwise the line is
+// dropped and counted. Callers check begin() first, so dropped lines also
+// cost no formatting time. After drops, the next line that goes out is
+// preceded by a "[N dropped]" note.
+class Trace : public Print {
+public:
+    // False when the budget is spent or muted; skip formatting the line
+    bool begin();
+    // While another protocol owns Serial (Modbus); muted lines are not counted
+    void setMuted(bool muted);
+    size_t write(uint8_t c) override;
+    using Print::write;
+    void printStats(Print& out) const;
+    void resetStats();
+private:
+    bool _muted = false;
+    bool _active = false;  // Between an admitting begin() and the newline
+    uint8_t _length = 0;
+    uint16_t _tokens = TRACE_BURST_BYTES;
+    unsigned long _refillMs = 0;
+    uint16_t _pendingDrops = 0;  // Not yet reported on the wire
+    uint16_t _sent = 0;
+    uint16_t _dropped = 0;
+
+    void refill();
+    void drop();
+};
+
+extern Trace trace;
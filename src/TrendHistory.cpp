@@ -0,0 +1,41 @@
+// src/TrendHistory.cpp
+#include "TrendHistory.h"
+#include <string.h>
+
+static const int16_t OFFSET = 1000;  // Centi-degrees below 0 C at code 0
+static const uint8_t STEP = 25;      // Centi-degrees per code
+
+void TrendHistory::push(centi_t room, bool roomValid, centi_t algae, bool algaeValid) {
+    _room[_head] = roomValid ? encode(room) : NO_DATA;
+    _algae[_head] = algaeValid ? encode(algae) : NO_DATA;
+    _head = _head + 1 < LENGTH ? _head + 1 : 0;
+}
+
+void TrendHistory::clear() {
+    memset(_room, NO_DATA, sizeof(_room));
+    memset(_algae, NO_DATA, sizeof(_algae));
+    _head = 0;
+}
+
+uint8_t TrendHistory::head() const {
+    return _head;
+}
+
+uint8_t TrendHistory::room(uint8_t slot) const {
+    return _room[slot];
+}
+
+uint8_t TrendHistory::algae(uint8_t slot) const {
+    return _algae[slot];
+}
+
+uint8_t TrendHistory::encode(centi_t value) {
+    int16_t code = ((int16_t)value + OFFSET + STEP / 2) / STEP;
+    if (code < 1) return 1;
+    if (code > 255) return 255;
+    return code;
+}
+
+centi_t TrendHistory::decode(uint8_t code) {
+    return (int16_t)code * STEP - OFFSET;
+}
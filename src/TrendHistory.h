@@ -0,0 +1,28 @@
+// src/TrendHistory.h
+#pragma once
+#include <stdint.h>
+#include "FixedPoint.h"
+
+// The last LENGTH room and algae readings for the LCD sparkline, one byte
+// each: quarter degrees from -10 C (1..255 covers -9.75..53.75 C), with 0
+// for a faulted reading. Slot i is overwritten every LENGTH readings, so a
+// slot maps to a fixed pixel column and only the newest column changes.
+class TrendHistory {
+public:
+    static const uint8_t LENGTH = 40;  // 8 CGRAM glyphs x 5 pixel columns
+    static const uint8_t NO_DATA = 0;
+
+    void push(centi_t room, bool roomValid, centi_t algae, bool algaeValid);
+    void clear();
+    // Slot the next reading goes into
+    uint8_t head() const;
+    uint8_t room(uint8_t slot) const;
+    uint8_t algae(uint8_t slot) const;
+
+    static uint8_t encode(centi_t value);
+    static centi_t decode(uint8_t code);
+private:
+    uint8_t _room[LENGTH] = {};
+    uint8_t _algae[LENGTH] = {};
+    uint8_t _head = 0;
+};
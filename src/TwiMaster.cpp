@@ -0,0 +1,276 @@
+// src/TwiMaster.cpp
+#include "TwiMaster.h"
+#include "Config.h"
+#include "RingBuffer.h"
+#include <Arduino.h>
+#include <avr/interrupt.h>
+#include <util/twi.h>
+
+enum TwiMode : uint8_t { MODE_IDLE, MODE_WRITE, MODE_READ, MODE_STREAM };
+
+static volatile TwiMode mode = MODE_IDLE;
+static volatile TwiMaster::Status lastStatus = TwiMaster::TWI_OK;
+static volatile uint8_t slaRw = 0;
+static uint8_t buffer[TwiMaster::BUFFER_SIZE];
+static volatile uint8_t bufferIndex = 0;
+static volatile uint8_t bufferLength = 0;
+static unsigned long startedMs = 0;    // Start, or last stream progress
+static uint32_t progressBytes = 0;
+
+static RingBuffer<uint8_t, TWI_STREAM_SIZE> stream;
+static RingBuffer<uint8_t, TWI_PACKET_SLOTS> packetLengths;
+static volatile uint8_t packetLeft = 0;  // Bytes left + 1 in a packet; 0 = unframed
+static uint8_t streamAddress = 0;
+static volatile uint32_t streamByteCount = 0;
+static volatile uint16_t errorCount = 0;
+static volatile bool streamFailed = false;  // Set by TWI_vect, handled by poll()
+
+static inline void reply(bool ack) {
+    TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT) | (ack ? _BV(TWEA) : 0);
+}
+
+static void finish(TwiMaster::Status status) {
+    TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTO);
+    if (mode == MODE_STREAM) {
+        if (status != TwiMaster::TWI_OK) {
+            // Not cleared here: queuePacket() may be between pushing a
+            // packet's bytes and its length. poll() drops the queue.
+            streamFailed = true;
+        }
+    } else {
+        lastStatus = status;
+    }
+    mode = MODE_IDLE;
+}
+
+// Caller has checked the bus is idle. A STOP may still be going out: the
+// START is then deferred by returning false.
+static bool start(TwiMode newMode, uint8_t sla) {
+    if (TWCR & _BV(TWSTO)) {
+        return false;
+    }
+    mode = newMode;
+    slaRw = sla;
+    bufferIndex = 0;
+    startedMs = millis();
+    TWCR = _BV(TWEN) | _BV(TWIE) | _BV(TWINT) | _BV(TWSTA);
+    return true;
+}
+
+ISR(TWI_vect) {
+    switch (TW_STATUS) {
+        case TW_START:
+        case TW_REP_START:
+            TWDR = slaRw;
+            if (mode == MODE_STREAM) streamByteCount++;
+            reply(false);
+            break;
+
+        case TW_MT_SLA_ACK:
+        case TW_MT_DATA_ACK:
+            if (mode == MODE_STREAM) {
+                uint8_t value;
+                if (packetLeft != 1 && stream.pop(value)) {
+                    TWDR = value;
+                    streamByteCount++;
+                    if (packetLeft) packetLeft--;
+                    reply(false);
+                } else {
+                    finish(TwiMaster::TWI_OK);
+                }
+            } else if (bufferIndex < bufferLength) {
+                TWDR = buffer[bufferIndex++];
+                reply(false);
+            } else {
+                finish(TwiMaster::TWI_OK);
+            }
+            break;
+
+        case TW_MR_DATA_ACK:
+            buffer[bufferIndex++] = TWDR;
+            // Fall through: ACK all but the last byte
+        case TW_MR_SLA_ACK:
+            reply(bufferIndex + 1 < bufferLength);
+            break;
+
+        case TW_MR_DATA_NACK:
+            buffer[bufferIndex++] = TWDR;
+            finish(TwiMaster::TWI_OK);
+            break;
+
+        case TW_MT_SLA_NACK:
+        case TW_MR_SLA_NACK:
+            finish(TwiMaster::TWI_NACK_ADDRESS);
+            break;
+
+        case TW_MT_DATA_NACK:
+            finish(TwiMaster::TWI_NACK_DATA);
+            break;
+
+        default:  // Bus error or lost arbitration: release the bus
+            finish(TwiMaster::TWI_BUS_ERROR);
+            break;
+    }
+}
+
+void TwiMaster::begin(uint32_t clockHz) {
+    // Internal pull-ups as Wire enables them; boards still need external 4.7k
+    digitalWrite(SDA, HIGH);
+    digitalWrite(SCL, HIGH);
+    TWSR = 0;  // Prescaler 1
+    TWBR = ((F_CPU / clockHz) - 16) / 2;
+    TWCR = _BV(TWEN);
+}
+
+void TwiMaster::poll() {
+    if (mode != MODE_IDLE) {
+        // A stream may run for as long as bytes keep being queued
+        uint32_t sent = streamBytes();
+        if (sent != progressBytes) {
+            progressBytes = sent;
+            startedMs = millis();
+        }
+        if (millis() - startedMs < TWI_TIMEOUT_MS) {
+            return;
+        }
+        // A slave holding SDA/SCL; reset the peripheral to release the bus
+        TWCR = 0;
+        TWCR = _BV(TWEN);
+        if (mode == MODE_STREAM) {
+            streamFailed = true;
+        } else {
+            lastStatus = TWI_BUS_ERROR;
+            errorCount++;
+        }
+        mode = MODE_IDLE;
+    }
+    if (streamFailed) {
+        // The rest of the queue would reach the device out of step (half an
+        // HD44780 byte, an SSD1306 packet boundary): drop all of it. poll()
+        // runs where the display queues, so only whole packets are queued,
+        // and TWI_vect is idle until the next start, so clearing here is
+        // safe. errors() moves only now, so DisplayManager's resync is
+        // queued after the drop.
+        streamFailed = false;
+        stream.clear();
+        packetLengths.clear();
+        errorCount++;
+    }
+    if (stream.size() > 0 && !(TWCR & _BV(TWSTO))) {
+        // packetLeft counts one past the packet so that 0 can mean unframed
+        uint8_t length;
+        packetLeft = packetLengths.pop(length) ? length + 1 : 0;
+        start(MODE_STREAM, streamAddress << 1 | TW_WRITE);
+    }
+}
+
+bool TwiMaster::startWrite(uint8_t address, const uint8_t* data, uint8_t length) {
+    if (mode != MODE_IDLE || length > BUFFER_SIZE) {
+        return false;
+    }
+    if (length > 0) {
+        memcpy(buffer, data, length);
+    }
+    bufferLength = length;
+    lastStatus = TWI_BUSY;
+    if (!start(MODE_WRITE, address << 1 | TW_WRITE)) {
+        lastStatus = TWI_OK;
+        return false;
+    }
+    return true;
+}
+
+bool TwiMaster::startRead(uint8_t address, uint8_t length) {
+    if (mode != MODE_IDLE || length == 0 || length > BUFFER_SIZE) {
+        return false;
+    }
+    bufferLength = length;
+    lastStatus = TWI_BUSY;
+    if (!start(MODE_READ, address << 1 | TW_READ)) {
+        lastStatus = TWI_OK;
+        return false;
+    }
+    return true;
+}
+
+TwiMaster::Status TwiMaster::status() {
+    return lastStatus;
+}
+
+const uint8_t* TwiMaster::readData() {
+    return buffer;
+}
+
+TwiMaster::Status TwiMaster::write(uint8_t address, const uint8_t* data, uint8_t length) {
+    while (!startWrite(address, data, length)) {
+        poll();  // Let a queued stream finish (or time out) first
+    }
+    while (status() == TWI_BUSY) {
+        poll();
+    }
+    return status();
+}
+
+TwiMaster::Status TwiMaster::read(uint8_t address, uint8_t* data, uint8_t length) {
+    while (!startRead(address, length)) {
+        poll();
+    }
+    while (status() == TWI_BUSY) {
+        poll();
+    }
+    if (status() == TWI_OK) {
+        memcpy(data, buffer, length);
+    }
+    return status();
+}
+
+void TwiMaster::setStreamAddress(uint8_t address) {
+    streamAddress = address;
+}
+
+bool TwiMaster::queue(uint8_t value) {
+    return stream.push(value);
+}
+
+bool TwiMaster::queuePacket(const uint8_t* data, uint8_t length) {
+    if (length == 0 || length > queueFree() || packetsFree() == 0) {
+        return false;
+    }
+    // Only poll() starts stream transactions, so the ISR cannot pick these
+    // bytes up before their length is queued
+    for (uint8_t i = 0; i < length; i++) {
+        stream.push(data[i]);
+    }
+    packetLengths.push(length);
+    return true;
+}
+
+uint8_t TwiMaster::packetsFree() {
+    return TWI_PACKET_SLOTS - 1 - packetLengths.size();
+}
+
+uint8_t TwiMaster::queueFree() {
+    return TWI_STREAM_SIZE - 1 - stream.size();
+}
+
+bool TwiMaster::streamIdle() {
+    return stream.size() == 0 && mode != MODE_STREAM;
+}
+
+bool TwiMaster::idle() {
+    return mode == MODE_IDLE && !(TWCR & _BV(TWSTO));
+}
+
+uint32_t TwiMaster::streamBytes() {
+    noInterrupts();
+    uint32_t count = streamByteCount;
+    interrupts();
+    return count;
+}
+
+uint16_t TwiMaster::errors() {
+    noInterrupts();
+    uint16_t count = errorCount;
+    interrupts();
+    return count;
+}
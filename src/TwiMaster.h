@@ -0,0 +1,52 @@
+// src/TwiMaster.h
+#pragma once
+#include <stdint.h>
+
+// Interrupt-driven TWI (I2C) master; replaces Wire, whose calls spin until
+// each transaction ends. Two kinds of traffic share the bus:
+//  - one-shot transactions of up to BUFFER_SIZE bytes (sensors, bus scan),
+//    started without waiting and checked later with status();
+//  - a background byte stream to one device (the display), refilled from
+//    TWI_vect, so queued bytes go out as a single long write. Devices that
+//    need a prefix per transaction (SSD1306 control byte) queue packets
+//    instead, and each packet becomes exactly one transaction.
+// Everything runs from TWI_vect; loop() only queues bytes and polls.
+class TwiMaster {
+public:
+    enum Status : uint8_t {
+        TWI_OK,
+        TWI_BUSY,          // Transaction still in progress
+        TWI_NACK_ADDRESS,  // No device (or device busy, e.g. SHT3x measuring)
+        TWI_NACK_DATA,
+        TWI_BUS_ERROR      // Bus error, lost arbitration or timeout
+    };
+    static const uint8_t BUFFER_SIZE = 8;
+
+    static void begin(uint32_t clockHz);
+    // Call every loop(): restarts the stream and recovers a hung bus
+    static void poll();
+
+    // False when the bus is taken; try again on a later pass
+    static bool startWrite(uint8_t address, const uint8_t* data, uint8_t length);
+    static bool startRead(uint8_t address, uint8_t length);
+    // Of the last one-shot transaction; TWI_BUSY until it ends
+    static Status status();
+    static const uint8_t* readData();
+    // Blocking wrappers for setup and interactive commands
+    static Status write(uint8_t address, const uint8_t* data, uint8_t length);
+    static Status read(uint8_t address, uint8_t* data, uint8_t length);
+
+    static void setStreamAddress(uint8_t address);
+    static bool queue(uint8_t value);
+    // All-or-nothing; false when the bytes or a packet slot are not free
+    static bool queuePacket(const uint8_t* data, uint8_t length);
+    static uint8_t queueFree();
+    static uint8_t packetsFree();
+    static bool streamIdle();
+    // No transaction of either kind on the bus
+    static bool idle();
+
+    // Stream bytes put on the wire, address bytes included
+    static uint32_t streamBytes();
+    static uint16_t errors();
+};
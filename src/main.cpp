@@ -5,29 +5,89 @@
 #include "SensorManager.h"
 #include "DisplayManager.h"
 #include "SerialCommander.h"
+#include "PowerManager.h"
+#include "TwiMaster.h"
+#include "ReadingStats.h"
+#include "Telemetry.h"
+#include "ReadingStreamer.h"
+#include "Scheduler.h"
+#include "Perf.h"
 
 SystemState state;
+ReadingStats readingStats;
+Telemetry telemetry;
+ReadingStreamer readingStreamer;
+Scheduler scheduler;
 SensorManager sensorManager(state);
-DisplayManager displayManager(state);
-SerialCommander serialCommander(state, sensorManager);
+DisplayManager displayManager(state, readingStats);
+PowerManager powerManager(state);
+SerialCommander serialCommander(state, sensorManager, powerManager, displayManager, readingStats,
+                                telemetry, readingStreamer, scheduler);
 
-unsigned long lastUpdate = 0;
+uint8_t requestTask;
+uint8_t renderTask;
+uint8_t logTask;
+
+void serviceSerial() {
+    serialCommander.process();
+}
+
+// Starts a sampling window; the period follows the adaptive interval
+void requestReading() {
+    sensorManager.requestReading();
+    scheduler.setPeriod(requestTask, sensorManager.readingInterval());
+}
+
+// Sampling advances one conversion per pass, so loop() never stalls
+void sample() {
+    if (sensorManager.update()) {
+        readingStats.update(state, millis());
+        powerManager.noteReading();
+        scheduler.wake(renderTask);
+        scheduler.wake(logTask);
+    }
+}
+
+void renderDisplay() {
+    displayManager.update();
+}
+
+// The LCD frame goes out a few bytes per pass; TWI_vect does the rest
+void refreshDisplay() {
+    displayManager.poll();
+    TwiMaster::poll();
+}
+
+void logReading() {
+    telemetry.send(state, millis());
+    readingStreamer.send(state, millis(), sensorManager.readingInterval());
+}
 
 void setup() {
-    Serial.begin(9600);
+    Serial.begin(SERIAL_BAUD);
+    TwiMaster::begin(I2C_CLOCK_HZ);  // Shared by the LCD and I2C sensors
     sensorManager.begin();
     displayManager.begin();
     displayManager.showWelcomeMessage();
     delay(1000);
     sensorManager.test();
+    serialCommander.begin();
+
+    // Budgets and deadlines are what each step normally needs with margin;
+    // see them against real runs with the `tasks` command
+    scheduler.addPolled(F("serial"), serviceSerial, 0, 2000);
+    scheduler.addPolled(F("sample"), sample, 1, 1000);
+    requestTask = scheduler.addPeriodic(F("request"), requestReading,
+                                        sensorManager.readingInterval(), 1);
+    logTask = scheduler.addEvent(F("log"), logReading, 2, 50);
+    renderTask = scheduler.addEvent(F("render"), renderDisplay, 3, 100);
+    scheduler.addPolled(F("display"), refreshDisplay, 3, 1000);
 }
 
 void loop() {
-    serialCommander.process();
-
-    if (millis() - lastUpdate >= UPDATE_INTERVAL) {
-        lastUpdate = millis();
-        sensorManager.update();
-        displayManager.update();
+    {
+        PerfScope perf(PERF_LOOP);
+        scheduler.run();
     }
+    powerManager.idle();
 }
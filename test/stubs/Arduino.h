@@ -0,0 +1,47 @@
+// test/stubs/Arduino.h
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Just enough of the Arduino core for the pure modules under native tests:
+// pin names for Config.h, the core's min/max/constrain macros and a Print
+// that the name printers can write to. Nothing here touches hardware.
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    size_t print(const char* s) {
+        size_t n = 0;
+        while (*s) {
+            n += write(*s++);
+        }
+        return n;
+    }
+    size_t print(const __FlashStringHelper* s) {
+        return print(reinterpret_cast<const char*>(s));
+    }
+    size_t print(char c) {
+        return write(c);
+    }
+};
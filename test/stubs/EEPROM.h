@@ -0,0 +1,27 @@
+// test/stubs/EEPROM.h
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+// 1 KB of RAM standing in for the ATmega328P EEPROM, erased (0xFF) at start
+struct EEPROMClass {
+    static uint8_t* cells() {
+        static uint8_t data[1024];
+        static bool erased = false;
+        if (!erased) {
+            memset(data, 0xFF, sizeof(data));
+            erased = true;
+        }
+        return data;
+    }
+    template <class T> T& get(int address, T& value) {
+        memcpy(&value, cells() + address, sizeof(T));
+        return value;
+    }
+    template <class T> const T& put(int address, const T& value) {
+        memcpy(cells() + address, &value, sizeof(T));
+        return value;
+    }
+};
+
+static EEPROMClass EEPROM;
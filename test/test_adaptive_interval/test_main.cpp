@@ -0,0 +1,117 @@
+// test/test_adaptive_interval/test_main.cpp
+#include <unity.h>
+#include "AdaptiveInterval.h"
+
+// One 12-bit code at 5 V, as SensorManager::notePublished() computes it
+static const uint16_t STEP = 13;
+
+static AdaptiveInterval* interval;
+static unsigned long nowMs;
+
+void setUp() {
+    static AdaptiveInterval fresh;
+    fresh = AdaptiveInterval();
+    interval = &fresh;
+    interval->setResolution(STEP);
+    nowMs = 0;
+}
+void tearDown() {}
+
+// What the ADC reports for a true temperature: whole codes only
+static centi_t quantize(int32_t centi) {
+    return (centi * 10 / 122) * 122 / 10;
+}
+
+// Feeds readings of a linear ramp on both roles at the controller's own
+// interval; milliCenti is the true temperature in 1/1000 centi-degree,
+// ratePerMinute in centi-degrees per minute
+static void ramp(int32_t& milliCenti, int32_t ratePerMinute, uint8_t readings) {
+    for (uint8_t i = 0; i < readings; i++) {
+        unsigned long ms = interval->interval();
+        nowMs += ms;
+        milliCenti += ratePerMinute * (int32_t)ms / 60;
+        centi_t reading = quantize(milliCenti / 1000);
+        interval->update(reading, true, reading, true, nowMs);
+    }
+}
+
+void test_one_degree_per_minute_tightens_from_max() {
+    interval->setBaseInterval(MAX_UPDATE_INTERVAL);
+    int32_t temperature = 2500000;
+    ramp(temperature, 100, 6);
+    TEST_ASSERT_TRUE(interval->interval() < MAX_UPDATE_INTERVAL);
+    ramp(temperature, 100, 40);
+    TEST_ASSERT_EQUAL_UINT32(MIN_UPDATE_INTERVAL, interval->interval());
+}
+
+void test_ramp_holds_the_short_interval() {
+    interval->setBaseInterval(MIN_UPDATE_INTERVAL);
+    int32_t temperature = 2500000;
+    ramp(temperature, 100, 120);  // A minute at 500 ms
+    TEST_ASSERT_EQUAL_UINT32(MIN_UPDATE_INTERVAL, interval->interval());
+    TEST_ASSERT_TRUE(interval->slewRate() >= ADAPT_FAST_SLEW);
+}
+
+void test_one_code_flicker_relaxes_to_max() {
+    interval->setBaseInterval(MIN_UPDATE_INTERVAL);
+    for (uint16_t i = 0; i < 400; i++) {
+        nowMs += interval->interval();
+        centi_t reading = i & 1 ? 2500 : 2500 + STEP;
+        interval->update(reading, true, reading, true, nowMs);
+    }
+    TEST_ASSERT_EQUAL_UINT32(MAX_UPDATE_INTERVAL, interval->interval());
+}
+
+void test_slow_drift_is_measured_not_lost() {
+    interval->setBaseInterval(MAX_UPDATE_INTERVAL);
+    int32_t temperature = 2500000;
+    ramp(temperature, 10, 60);  // 0.1 C/min for 16 minutes
+    TEST_ASSERT_TRUE(interval->slewRate() > 0);
+    TEST_ASSERT_TRUE(interval->slewRate() <= ADAPT_SLOW_SLEW);
+    TEST_ASSERT_EQUAL_UINT32(MAX_UPDATE_INTERVAL, interval->interval());
+}
+
+// A role coming back from a fault is primed afresh, not compared with the
+// value it had before the fault
+void test_invalid_role_restarts_its_baseline() {
+    interval->setBaseInterval(MAX_UPDATE_INTERVAL);
+    interval->update(2500, true, 2200, true, nowMs += 16000);
+    interval->update(0, false, 2200, true, nowMs += 16000);
+    interval->update(9000, true, 2200, true, nowMs += 16000);
+    interval->update(9000, true, 2200, true, nowMs += 16000);
+    TEST_ASSERT_EQUAL_UINT16(0, interval->slewRate());
+}
+
+void test_disabled_keeps_base_interval() {
+    interval->setBaseInterval(4000);
+    interval->setEnabled(false);
+    int32_t temperature = 2500000;
+    ramp(temperature, 300, 20);
+    TEST_ASSERT_EQUAL_UINT32(4000, interval->interval());
+    TEST_ASSERT_TRUE(interval->slewRate() >= ADAPT_FAST_SLEW);
+}
+
+// At OVERSAMPLE_BITS 3 one window outlasts MIN_UPDATE_INTERVAL
+void test_interval_stays_above_window_length() {
+    interval->setMinInterval(1290);
+    int32_t temperature = 2500000;
+    ramp(temperature, 300, 40);
+    TEST_ASSERT_EQUAL_UINT32(1290, interval->interval());
+    interval->setBaseInterval(MIN_UPDATE_INTERVAL);
+    TEST_ASSERT_EQUAL_UINT32(1290, interval->interval());
+    interval->setMinInterval(330);  // Back to 2 bits: MIN_UPDATE_INTERVAL rules again
+    ramp(temperature, 300, 10);
+    TEST_ASSERT_EQUAL_UINT32(MIN_UPDATE_INTERVAL, interval->interval());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_one_degree_per_minute_tightens_from_max);
+    RUN_TEST(test_ramp_holds_the_short_interval);
+    RUN_TEST(test_one_code_flicker_relaxes_to_max);
+    RUN_TEST(test_slow_drift_is_measured_not_lost);
+    RUN_TEST(test_invalid_role_restarts_its_baseline);
+    RUN_TEST(test_disabled_keeps_base_interval);
+    RUN_TEST(test_interval_stays_above_window_length);
+    return UNITY_END();
+}
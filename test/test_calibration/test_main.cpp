@@ -0,0 +1,93 @@
+// test/test_calibration/test_main.cpp
+#include <unity.h>
+#include "Calibration.h"
+
+static Calibration cal;
+
+void setUp() {
+    cal.load();  // Blank or left over from the last test: either way a known start
+    for (uint8_t slot = 0; slot < Calibration::SLOTS; slot++) {
+        cal.clear(slot);
+    }
+}
+void tearDown() {}
+
+void test_uncalibrated_slot_passes_through() {
+    TEST_ASSERT_EQUAL_INT16(2437, cal.apply(0, 2437));
+    TEST_ASSERT_EQUAL_INT16(2437, cal.apply(Calibration::SLOTS, 2437));
+}
+
+void test_single_point_is_an_offset() {
+    cal.addPoint(0, 2500, 2550);
+    TEST_ASSERT_EQUAL_INT16(2450, cal.apply(0, 2400));
+    TEST_ASSERT_EQUAL_INT16(2437, cal.apply(1, 2437));
+}
+
+void test_two_points_interpolate_and_extrapolate() {
+    cal.addPoint(0, 1000, 1100);
+    cal.addPoint(0, 3000, 3300);  // Gain 1.1, truncated to Q12
+    TEST_ASSERT_EQUAL_INT16(1100, cal.apply(0, 1000));
+    TEST_ASSERT_INT16_WITHIN(1, 2200, cal.apply(0, 2000));
+    TEST_ASSERT_INT16_WITHIN(1, 3300, cal.apply(0, 3000));
+    TEST_ASSERT_INT16_WITHIN(1, 4400, cal.apply(0, 4000));
+    TEST_ASSERT_INT16_WITHIN(1, 0, cal.apply(0, 0));
+}
+
+void test_three_points_pick_the_segment() {
+    cal.addPoint(0, 3000, 3000);
+    cal.addPoint(0, 1000, 1000);
+    cal.addPoint(0, 2000, 2200);  // Added out of order on purpose
+    TEST_ASSERT_EQUAL_UINT8(3, cal.pointCount(0));
+    TEST_ASSERT_INT16_WITHIN(1, 1600, cal.apply(0, 1500));
+    TEST_ASSERT_INT16_WITHIN(1, 2600, cal.apply(0, 2500));
+}
+
+// toCentiDegrees() saturates at 32767; calibration must not wrap it negative
+void test_saturated_reading_with_offset_stays_saturated() {
+    cal.addPoint(0, 2500, 2600);
+    TEST_ASSERT_EQUAL_INT16(32767, cal.apply(0, 32767));
+}
+
+void test_saturated_reading_with_gain_stays_saturated() {
+    cal.addPoint(0, 1000, 1000);
+    cal.addPoint(0, 3000, 3200);
+    TEST_ASSERT_EQUAL_INT16(32767, cal.apply(0, 32767));
+}
+
+void test_negative_side_clamps() {
+    cal.addPoint(0, 2500, 2400);
+    TEST_ASSERT_EQUAL_INT16(-32767, cal.apply(0, -32767));
+}
+
+void test_full_slot_replaces_nearest_point() {
+    cal.addPoint(0, 1000, 1000);
+    cal.addPoint(0, 2000, 2000);
+    cal.addPoint(0, 3000, 3000);
+    cal.addPoint(0, 2100, 2300);
+    TEST_ASSERT_EQUAL_UINT8(3, cal.pointCount(0));
+    TEST_ASSERT_EQUAL_INT16(2100, cal.point(0, 1).measured);
+    TEST_ASSERT_EQUAL_INT16(2300, cal.point(0, 1).reference);
+}
+
+void test_save_and_load_round_trip() {
+    cal.addPoint(2, 2500, 2550);
+    cal.save();
+    Calibration loaded;
+    TEST_ASSERT_TRUE(loaded.load());
+    TEST_ASSERT_EQUAL_UINT8(1, loaded.pointCount(2));
+    TEST_ASSERT_EQUAL_INT16(2450, loaded.apply(2, 2400));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_uncalibrated_slot_passes_through);
+    RUN_TEST(test_single_point_is_an_offset);
+    RUN_TEST(test_two_points_interpolate_and_extrapolate);
+    RUN_TEST(test_three_points_pick_the_segment);
+    RUN_TEST(test_saturated_reading_with_offset_stays_saturated);
+    RUN_TEST(test_saturated_reading_with_gain_stays_saturated);
+    RUN_TEST(test_negative_side_clamps);
+    RUN_TEST(test_full_slot_replaces_nearest_point);
+    RUN_TEST(test_save_and_load_round_trip);
+    return UNITY_END();
+}
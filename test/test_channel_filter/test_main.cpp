@@ -0,0 +1,139 @@
+// test/test_channel_filter/test_main.cpp
+#include <unity.h>
+#include "Config.h"
+#include "ChannelFilter.h"
+
+static ChannelFilter filter;
+
+void setUp() {
+    filter = ChannelFilter();
+}
+void tearDown() {}
+
+void test_none_passes_through() {
+    TEST_ASSERT_EQUAL_INT16(2437, filter.update(2437));
+    TEST_ASSERT_EQUAL_INT16(-150, filter.update(-150));
+}
+
+void test_ema_starts_at_first_sample() {
+    filter.configure(FILTER_EMA, 2);
+    TEST_ASSERT_EQUAL_INT16(2500, filter.update(2500));
+}
+
+void test_ema_weight() {
+    filter.configure(FILTER_EMA, 2);
+    filter.update(0);
+    TEST_ASSERT_EQUAL_INT16(250, filter.update(1000));   // 1/4 of the step
+    TEST_ASSERT_EQUAL_INT16(438, filter.update(1000));   // 1/4 of what is left
+    for (uint8_t i = 0; i < 60; i++) {
+        filter.update(1000);
+    }
+    TEST_ASSERT_EQUAL_INT16(1000, filter.update(1000));
+}
+
+// At the heaviest weight a small step still settles exactly, both ways
+void test_ema_settles_on_small_steps() {
+    filter.configure(FILTER_EMA, 6);
+    filter.update(2500);
+    for (uint16_t i = 0; i < 500; i++) {
+        filter.update(2510);
+    }
+    TEST_ASSERT_EQUAL_INT16(2510, filter.update(2510));
+    for (uint16_t i = 0; i < 500; i++) {
+        filter.update(2500);
+    }
+    TEST_ASSERT_EQUAL_INT16(2500, filter.update(2500));
+}
+
+void test_ema_param_limits() {
+    filter.configure(FILTER_EMA, 9);
+    TEST_ASSERT_EQUAL_UINT8(6, filter.param());
+    filter.configure(FILTER_EMA);
+    TEST_ASSERT_EQUAL_UINT8(FILTER_EMA_SHIFT, filter.param());
+    filter.configure(FILTER_KALMAN, 250);
+    TEST_ASSERT_EQUAL_UINT8(200, filter.param());
+    filter.configure(FILTER_KALMAN);
+    TEST_ASSERT_EQUAL_UINT8(FILTER_KALMAN_NOISE, filter.param());
+}
+
+void test_median_warm_up() {
+    filter.configure(FILTER_MEDIAN);
+    TEST_ASSERT_EQUAL_INT16(2500, filter.update(2500));
+    TEST_ASSERT_EQUAL_INT16(2600, filter.update(2600));  // Upper of two
+    TEST_ASSERT_EQUAL_INT16(2500, filter.update(2400));
+}
+
+void test_median_rejects_spikes() {
+    filter.configure(FILTER_MEDIAN);
+    const centi_t samples[] = { 2500, 2501, 9999, 2502, 2499, -500, 2500, 2503 };
+    for (uint8_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        TEST_ASSERT_INT16_WITHIN(4, 2501, filter.update(samples[i]));
+    }
+}
+
+// Once full, each update evicts the oldest sample, duplicates included
+void test_median_window_slides() {
+    filter.configure(FILTER_MEDIAN);
+    for (uint8_t i = 0; i < ChannelFilter::MEDIAN_WINDOW; i++) {
+        filter.update(100);
+    }
+    filter.update(300);
+    filter.update(300);
+    TEST_ASSERT_EQUAL_INT16(300, filter.update(300));  // 100 100 300 300 300
+    filter.update(200);
+    filter.update(200);
+    TEST_ASSERT_EQUAL_INT16(200, filter.update(200));  // 300 300 200 200 200
+}
+
+void test_kalman_starts_at_first_sample() {
+    filter.configure(FILTER_KALMAN, 20);
+    TEST_ASSERT_EQUAL_INT16(2500, filter.update(2500));
+    TEST_ASSERT_EQUAL_INT16(2500, filter.update(2500));
+}
+
+void test_kalman_converges_on_a_step() {
+    filter.configure(FILTER_KALMAN, 20);
+    filter.update(2000);
+    centi_t last = 2000;
+    for (uint8_t i = 0; i < 40; i++) {
+        centi_t out = filter.update(3000);
+        TEST_ASSERT_TRUE(out >= last && out <= 3000);
+        last = out;
+    }
+    TEST_ASSERT_INT16_WITHIN(5, 3000, last);
+}
+
+void test_kalman_smooths_noise() {
+    filter.configure(FILTER_KALMAN, 50);
+    for (uint8_t i = 0; i < 40; i++) {
+        filter.update(i & 1 ? 2550 : 2450);
+    }
+    for (uint8_t i = 0; i < 20; i++) {
+        TEST_ASSERT_INT16_WITHIN(30, 2500, filter.update(i & 1 ? 2550 : 2450));
+    }
+}
+
+void test_reconfigure_resets_state() {
+    filter.configure(FILTER_EMA, 2);
+    filter.update(0);
+    filter.update(1000);
+    filter.configure(FILTER_EMA, 2);
+    TEST_ASSERT_EQUAL_INT16(1000, filter.update(1000));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_none_passes_through);
+    RUN_TEST(test_ema_starts_at_first_sample);
+    RUN_TEST(test_ema_weight);
+    RUN_TEST(test_ema_settles_on_small_steps);
+    RUN_TEST(test_ema_param_limits);
+    RUN_TEST(test_median_warm_up);
+    RUN_TEST(test_median_rejects_spikes);
+    RUN_TEST(test_median_window_slides);
+    RUN_TEST(test_kalman_starts_at_first_sample);
+    RUN_TEST(test_kalman_converges_on_a_step);
+    RUN_TEST(test_kalman_smooths_noise);
+    RUN_TEST(test_reconfigure_resets_state);
+    return UNITY_END();
+}
@@ -0,0 +1,113 @@
+// test/test_cobs/test_main.cpp
+#include <unity.h>
+#include <string.h>
+#include "Cobs.h"
+#include "Crc16.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Reference decoder, as a host collector would write it
+static uint8_t decode(const uint8_t* in, uint8_t length, uint8_t* out) {
+    uint8_t outIndex = 0;
+    uint8_t i = 0;
+    while (i < length) {
+        uint8_t code = in[i++];
+        for (uint8_t k = 1; k < code; k++) {
+            out[outIndex++] = in[i++];
+        }
+        if (code != 0xFF && i < length) {
+            out[outIndex++] = 0;
+        }
+    }
+    return outIndex;
+}
+
+static void checkEncode(const uint8_t* in, uint8_t length, const uint8_t* expected,
+                        uint8_t expectedLength) {
+    uint8_t out[256];
+    uint8_t encoded = Cobs::encode(in, length, out);
+    TEST_ASSERT_EQUAL_UINT8(expectedLength, encoded);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, out, expectedLength);
+}
+
+void test_single_zero() {
+    const uint8_t in[] = { 0x00 };
+    const uint8_t expected[] = { 0x01, 0x01 };
+    checkEncode(in, sizeof(in), expected, sizeof(expected));
+}
+
+void test_two_zeros() {
+    const uint8_t in[] = { 0x00, 0x00 };
+    const uint8_t expected[] = { 0x01, 0x01, 0x01 };
+    checkEncode(in, sizeof(in), expected, sizeof(expected));
+}
+
+void test_zero_between_data() {
+    const uint8_t in[] = { 0x11, 0x22, 0x00, 0x33 };
+    const uint8_t expected[] = { 0x03, 0x11, 0x22, 0x02, 0x33 };
+    checkEncode(in, sizeof(in), expected, sizeof(expected));
+}
+
+void test_no_zero() {
+    const uint8_t in[] = { 0x11, 0x22, 0x33, 0x44 };
+    const uint8_t expected[] = { 0x05, 0x11, 0x22, 0x33, 0x44 };
+    checkEncode(in, sizeof(in), expected, sizeof(expected));
+}
+
+void test_trailing_zeros() {
+    const uint8_t in[] = { 0x11, 0x00, 0x00, 0x00 };
+    const uint8_t expected[] = { 0x02, 0x11, 0x01, 0x01, 0x01 };
+    checkEncode(in, sizeof(in), expected, sizeof(expected));
+}
+
+void test_longest_run_without_zero() {
+    uint8_t in[253];
+    uint8_t expected[254];
+    for (uint8_t i = 0; i < sizeof(in); i++) {
+        in[i] = i + 1;
+        expected[i + 1] = i + 1;
+    }
+    expected[0] = 0xFE;
+    checkEncode(in, sizeof(in), expected, sizeof(expected));
+}
+
+// A telemetry-shaped packet: header, channels with zero bytes, CRC
+void test_packet_round_trip() {
+    uint8_t packet[] = {
+        0x01, 0x01, 0x2A, 0x00, 0x10, 0x27, 0x00, 0x00, 0x02,
+        0x85, 0x09, 0x00, 0x6A, 0xFF, 0x05, 0x00, 0x00
+    };
+    uint16_t crc = crc16(packet, sizeof(packet) - 2);
+    packet[sizeof(packet) - 2] = crc & 0xFF;
+    packet[sizeof(packet) - 1] = crc >> 8;
+
+    uint8_t encoded[sizeof(packet) + 1];
+    uint8_t length = Cobs::encode(packet, sizeof(packet), encoded);
+    TEST_ASSERT_EQUAL_UINT8(sizeof(packet) + 1, length);
+    TEST_ASSERT_NULL(memchr(encoded, 0x00, length));
+
+    uint8_t decoded[sizeof(packet)];
+    TEST_ASSERT_EQUAL_UINT8(sizeof(packet), decode(encoded, length, decoded));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(packet, decoded, sizeof(packet));
+    TEST_ASSERT_EQUAL_HEX16(crc, crc16(decoded, sizeof(decoded) - 2));
+}
+
+// CRC-16/MODBUS check value
+void test_crc_check_value() {
+    const uint8_t digits[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_HEX16(0x4B37, crc16(digits, sizeof(digits)));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_single_zero);
+    RUN_TEST(test_two_zeros);
+    RUN_TEST(test_zero_between_data);
+    RUN_TEST(test_no_zero);
+    RUN_TEST(test_trailing_zeros);
+    RUN_TEST(test_longest_run_without_zero);
+    RUN_TEST(test_packet_round_trip);
+    RUN_TEST(test_crc_check_value);
+    return UNITY_END();
+}
@@ -0,0 +1,90 @@
+// test/test_fault_detector/test_main.cpp
+#include <unity.h>
+#include "Config.h"
+#include "FaultDetector.h"
+
+// 10-bit codes at 5 V, no oversampling, at the shortest reading interval
+static const uint16_t REF_MV = 5000;
+static const uint16_t STEP = 49;
+static const unsigned long INTERVAL_MS = MIN_UPDATE_INTERVAL;
+
+static FaultDetector detector;
+static unsigned long nowMs;
+
+void setUp() {
+    detector = FaultDetector();
+    nowMs = 0;
+}
+void tearDown() {}
+
+static centi_t toCenti(uint16_t code) {
+    return ((uint32_t)code * REF_MV * 10 + 512) >> 10;
+}
+
+// One window of a steady sensor at code; spread adds raw noise around it
+static SensorFault window(uint16_t code, uint16_t spread = 0) {
+    nowMs += INTERVAL_MS;
+    return detector.check(code, code + spread, code, toCenti(code), STEP, REF_MV, nowMs);
+}
+
+void test_one_code_flicker_is_not_slew() {
+    for (uint8_t i = 0; i < 40; i++) {
+        TEST_ASSERT_EQUAL_UINT8(FAULT_NONE, window(i & 1 ? 51 : 52));
+    }
+}
+
+void test_two_code_flicker_is_not_slew() {
+    for (uint8_t i = 0; i < 40; i++) {
+        TEST_ASSERT_EQUAL_UINT8(FAULT_NONE, window(i & 1 ? 50 : 52));
+    }
+}
+
+void test_fast_jump_is_slew() {
+    window(51);
+    TEST_ASSERT_EQUAL_UINT8(FAULT_SLEW, window(61));  // ~4.9 C in 500 ms
+}
+
+void test_slew_scales_with_elapsed_time() {
+    window(51);
+    nowMs += 10000;
+    TEST_ASSERT_EQUAL_UINT8(FAULT_NONE, window(61));  // Same jump over 10.5 s
+}
+
+void test_open_output() {
+    TEST_ASSERT_EQUAL_UINT8(FAULT_OPEN, window(0));
+}
+
+void test_rail() {
+    TEST_ASSERT_EQUAL_UINT8(FAULT_SATURATED, window(1023));
+}
+
+void test_out_of_range() {
+    TEST_ASSERT_EQUAL_UINT8(FAULT_RANGE, window(300));  // ~146 C
+}
+
+void test_noisy_window() {
+    TEST_ASSERT_EQUAL_UINT8(FAULT_NOISY, window(51, 20));  // ~98 mV spread
+}
+
+void test_stuck_only_after_hours() {
+    window(51);
+    nowMs += (FAULT_STUCK_MINUTES - 1) * 60000UL;
+    TEST_ASSERT_EQUAL_UINT8(FAULT_NONE, window(51));
+    nowMs += 60000UL;
+    TEST_ASSERT_EQUAL_UINT8(FAULT_STUCK, window(51));
+    TEST_ASSERT_EQUAL_UINT8(FAULT_NONE, window(52));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_one_code_flicker_is_not_slew);
+    RUN_TEST(test_two_code_flicker_is_not_slew);
+    RUN_TEST(test_fast_jump_is_slew);
+    RUN_TEST(test_slew_scales_with_elapsed_time);
+    RUN_TEST(test_open_output);
+    RUN_TEST(test_rail);
+    RUN_TEST(test_out_of_range);
+    RUN_TEST(test_noisy_window);
+    RUN_TEST(test_stuck_only_after_hours);
+    return UNITY_END();
+}
@@ -0,0 +1,76 @@
+// test/test_latency_histogram/test_main.cpp
+#include <unity.h>
+#include "LatencyHistogram.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_empty() {
+    LatencyHistogram h;
+    TEST_ASSERT_EQUAL_UINT32(0, h.count());
+    TEST_ASSERT_EQUAL_UINT32(0, h.maximum());
+    TEST_ASSERT_EQUAL_UINT32(0, h.percentile(50));
+}
+
+// Percentiles land in the right log2 bucket and never exceed the maximum
+void test_percentiles_within_bucket() {
+    LatencyHistogram h;
+    for (uint16_t i = 0; i < 99; i++) {
+        h.record(300);  // Bucket [256, 511]
+    }
+    h.record(5000);
+    TEST_ASSERT_EQUAL_UINT32(100, h.count());
+    TEST_ASSERT_EQUAL_UINT32(5000, h.maximum());
+    uint32_t p50 = h.percentile(50);
+    TEST_ASSERT_TRUE(p50 >= 256 && p50 <= 511);
+    uint32_t p99 = h.percentile(99);
+    TEST_ASSERT_TRUE(p99 >= 256 && p99 <= 511);
+}
+
+void test_percentile_clamped_to_maximum() {
+    LatencyHistogram h;
+    for (uint8_t i = 0; i < 10; i++) {
+        h.record(100);
+    }
+    TEST_ASSERT_TRUE(h.percentile(99) <= 100);
+}
+
+void test_zero_and_huge_values() {
+    LatencyHistogram h;
+    h.record(0);
+    h.record(4000000000UL);
+    TEST_ASSERT_EQUAL_UINT32(2, h.count());
+    TEST_ASSERT_EQUAL_UINT32(4000000000UL, h.maximum());
+    TEST_ASSERT_EQUAL_UINT32(4000000000UL, h.percentile(99));
+}
+
+// A full bucket halves every bucket instead of wrapping
+void test_halves_instead_of_overflowing() {
+    LatencyHistogram h;
+    for (uint32_t i = 0; i < 70000; i++) {
+        h.record(10);
+    }
+    uint32_t count = h.count();
+    TEST_ASSERT_TRUE(count > 30000 && count <= 0xFFFF);
+    uint32_t p50 = h.percentile(50);
+    TEST_ASSERT_TRUE(p50 >= 8 && p50 <= 10);
+}
+
+void test_reset() {
+    LatencyHistogram h;
+    h.record(123);
+    h.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, h.count());
+    TEST_ASSERT_EQUAL_UINT32(0, h.maximum());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty);
+    RUN_TEST(test_percentiles_within_bucket);
+    RUN_TEST(test_percentile_clamped_to_maximum);
+    RUN_TEST(test_zero_and_huge_values);
+    RUN_TEST(test_halves_instead_of_overflowing);
+    RUN_TEST(test_reset);
+    return UNITY_END();
+}
@@ -0,0 +1,114 @@
+// test/test_modbus_rtu/test_main.cpp
+#include <unity.h>
+#include <string.h>
+#include "ModbusRtu.h"
+
+static const uint8_t ADDRESS = 1;
+
+void setUp() {}
+void tearDown() {}
+
+// Appends the CRC, low byte first; returns the frame length
+static uint8_t seal(uint8_t* frame, uint8_t length) {
+    uint16_t crc = ModbusRtu::crc(frame, length);
+    frame[length++] = crc & 0xFF;
+    frame[length++] = crc >> 8;
+    return length;
+}
+
+void test_crc_check_value() {
+    const uint8_t digits[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_HEX16(0x4B37, ModbusRtu::crc(digits, sizeof(digits)));
+}
+
+// Read 10 holding registers from slave 1, the usual spec example
+void test_crc_valid_reference_frame() {
+    uint8_t frame[] = { 0x01, 0x03, 0x00, 0x00, 0x00, 0x0A, 0xC5, 0xCD };
+    TEST_ASSERT_TRUE(ModbusRtu::crcValid(frame, sizeof(frame)));
+    frame[5] ^= 0x01;
+    TEST_ASSERT_FALSE(ModbusRtu::crcValid(frame, sizeof(frame)));
+}
+
+void test_crc_valid_rejects_short_frames() {
+    const uint8_t frame[] = { 0x01, 0x03, 0x00 };
+    TEST_ASSERT_FALSE(ModbusRtu::crcValid(frame, sizeof(frame)));
+}
+
+void test_request_lengths() {
+    const uint8_t read[] = { ADDRESS, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00 };
+    TEST_ASSERT_EQUAL_UINT16(8, ModbusRtu::requestLength(read, sizeof(read), ADDRESS));
+
+    const uint8_t writeSingle[] = { ADDRESS, 0x06, 0x00, 0x04, 0x0F, 0xA0, 0x00, 0x00 };
+    TEST_ASSERT_EQUAL_UINT16(8, ModbusRtu::requestLength(writeSingle, 8, ADDRESS));
+
+    // Two registers: 7 header bytes, 4 value bytes, CRC
+    const uint8_t writeMultiple[] = { ADDRESS, 0x10, 0x00, 0x00, 0x00, 0x02, 0x04, 0, 1, 0, 1 };
+    TEST_ASSERT_EQUAL_UINT16(13, ModbusRtu::requestLength(writeMultiple, 13, ADDRESS));
+}
+
+void test_request_length_rejects() {
+    const uint8_t other[] = { 2, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00 };
+    TEST_ASSERT_EQUAL_UINT16(0, ModbusRtu::requestLength(other, 8, ADDRESS));
+
+    const uint8_t broadcast[] = { 0, 0x06, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00 };
+    TEST_ASSERT_EQUAL_UINT16(8, ModbusRtu::requestLength(broadcast, 8, ADDRESS));
+
+    const uint8_t unknown[] = { ADDRESS, 0x05, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00 };
+    TEST_ASSERT_EQUAL_UINT16(0, ModbusRtu::requestLength(unknown, 8, ADDRESS));
+
+    TEST_ASSERT_EQUAL_UINT16(0, ModbusRtu::requestLength(unknown, 7, ADDRESS));
+}
+
+// Another slave's reply and our next request arrive as one buffer
+void test_finds_request_behind_foreign_reply() {
+    uint8_t buffer[32];
+    const uint8_t reply[] = { 0x02, 0x03, 0x04, 0x00, 0x01, 0x00, 0x02 };
+    memcpy(buffer, reply, sizeof(reply));
+    uint8_t length = seal(buffer, sizeof(reply));
+    uint8_t start = length;
+    const uint8_t request[] = { ADDRESS, 0x04, 0x00, 0x00, 0x00, 0x01 };
+    memcpy(buffer + length, request, sizeof(request));
+    length = start + seal(buffer + start, sizeof(request));
+
+    TEST_ASSERT_FALSE(ModbusRtu::crcValid(buffer, length));
+    TEST_ASSERT_EQUAL_UINT8(start, ModbusRtu::findTrailingRequest(buffer, length, ADDRESS));
+}
+
+void test_finds_write_multiple_behind_noise() {
+    uint8_t buffer[32] = { 0x55, 0xAA, 0x00, 0x13 };
+    uint8_t start = 4;
+    const uint8_t request[] = { ADDRESS, 0x10, 0x00, 0x00, 0x00, 0x02, 0x04, 0, 1, 0, 1 };
+    memcpy(buffer + start, request, sizeof(request));
+    uint8_t length = start + seal(buffer + start, sizeof(request));
+    TEST_ASSERT_EQUAL_UINT8(start, ModbusRtu::findTrailingRequest(buffer, length, ADDRESS));
+}
+
+void test_no_request_in_garbage() {
+    uint8_t buffer[24];
+    for (uint8_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = i * 37 + 11;
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, ModbusRtu::findTrailingRequest(buffer, sizeof(buffer), ADDRESS));
+}
+
+void test_trailing_request_for_other_slave_is_ignored() {
+    uint8_t buffer[24] = { 0x99, 0x98, 0x97 };
+    const uint8_t request[] = { 3, 0x04, 0x00, 0x00, 0x00, 0x01 };
+    memcpy(buffer + 3, request, sizeof(request));
+    uint8_t length = 3 + seal(buffer + 3, sizeof(request));
+    TEST_ASSERT_EQUAL_UINT8(0, ModbusRtu::findTrailingRequest(buffer, length, ADDRESS));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_crc_check_value);
+    RUN_TEST(test_crc_valid_reference_frame);
+    RUN_TEST(test_crc_valid_rejects_short_frames);
+    RUN_TEST(test_request_lengths);
+    RUN_TEST(test_request_length_rejects);
+    RUN_TEST(test_finds_request_behind_foreign_reply);
+    RUN_TEST(test_finds_write_multiple_behind_noise);
+    RUN_TEST(test_no_request_in_garbage);
+    RUN_TEST(test_trailing_request_for_other_slave_is_ignored);
+    return UNITY_END();
+}